@@ -2,7 +2,7 @@
 #include <random>
 #include <algorithm>
 
-BFS::BFS(const Graph* graph) : SearchAlgorithm(graph) {}
+BFS::BFS(const Graph* graph, TraceLevel trace) : SearchAlgorithm(graph, trace) {}
 
 std::string BFS::GetAlgorithmName() const {
   return "BFS";
@@ -11,80 +11,85 @@ std::string BFS::GetAlgorithmName() const {
 // Función auxiliar para hacer BFS desde cualquier nodo
 SearchResult BFS::BFS_From_Node(int start, int goal) {
   Reset();
-  while (!frontier_.empty()) {
-    frontier_.pop();
-  }
-  explored_.clear();
   
   SearchResult result;
   
-  if (!graph_->IsValidVertex(start) || !graph_->IsValidVertex(goal)) {
+  if (!graph_->IsValidVertex(start) || (goal != kNoGoal && !graph_->IsValidVertex(goal))) {
+    return result;
+  }
+  
+  // La búsqueda trabaja con la numeración interna del grafo
+  start = graph_->ToInternal(start);
+  goal = graph_->ToInternal(goal);
+  
+  // Sin camino posible no hace falta explorar la componente del origen
+  if (goal != kNoGoal && !graph_->SameComponent(start, goal)) {
+    result.unreachable = true;
+    FinishResult(result);
     return result;
   }
   
-  std::shared_ptr<Node> start_node = std::make_shared<Node>(start);
-  frontier_.push(start_node);
+  nodes_.Add(start, Node::kNoParent, 0.0);
   MarkNodeGenerated(start);
   
   AddIteration();
   
-  while (!frontier_.empty()) {
-    std::shared_ptr<Node> current_node = frontier_.front();
-    frontier_.pop();
-    
-    int current_vertex = current_node->GetVertex();
+  // La cola de nodos por explorar son los nodos del arena en orden de
+  // generación, desde current_node hasta el último añadido
+  for (int current_node = 0; current_node < nodes_.Size(); ++current_node) {
+    // Copias: añadir vecinos al arena puede mover sus nodos
+    int current_vertex = nodes_[current_node].GetVertex();
+    double current_cost = nodes_[current_node].GetPathCost();
     
-    if (explored_.find(current_vertex) != explored_.end()) {
+    if (explored_.Contains(current_vertex)) {
       continue;
     }
     
-    explored_.insert(current_vertex);
+    explored_.Insert(current_vertex);
     MarkNodeInspected(current_vertex);
     
     if (current_vertex == goal) {
       result.path_found = true;
       result.path = ReconstructPath(current_node);
       result.total_cost = CalculatePathCost(result.path);
-      result.iterations = iterations_;
+      FinishResult(result);
       return result;
     }
     
-    std::vector<int> neighbors = graph_->GetNeighbors(current_vertex);
-    for (int neighbor : neighbors) {
+    graph_->ForEachNeighbor(current_vertex, [&](int neighbor, double edge_cost) {
       // Solo generar y añadir a la frontera si no ha sido explorado
-      if (explored_.find(neighbor) == explored_.end()) {
+      if (!explored_.Contains(neighbor)) {
         MarkNodeGenerated(neighbor);
         
-        double edge_cost = graph_->GetEdgeCost(current_vertex, neighbor);
-        double new_path_cost = current_node->GetPathCost() + edge_cost;
-        
-        std::shared_ptr<Node> neighbor_node = std::make_shared<Node>(neighbor, current_node, new_path_cost);
-        frontier_.push(neighbor_node);
+        nodes_.Add(neighbor, current_node, current_cost + edge_cost);
       }
-    }
+    });
     
     AddIteration();
   }
   
-  result.iterations = iterations_;
+  FinishResult(result);
   return result;
 }
 
 SearchResult BFS::Search(int start, int goal) {
-  if (!graph_->IsValidVertex(start) || !graph_->IsValidVertex(goal)) {
+  if (!graph_->IsValidVertex(start) || (goal != kNoGoal && !graph_->IsValidVertex(goal))) {
     SearchResult result;
     return result;
   }
   
+  // Sin destino basta con recorrer una vez la componente del origen, y si el
+  // destino está en otra componente tampoco hay camino desde sus hijos
   SearchResult result = BFS_From_Node(start, goal);
-  if (result.path_found) {
+  if (result.path_found || result.unreachable || goal == kNoGoal) {
     return result;
   }
   
   std::random_device rd;
   std::mt19937 gen(rd());
   
-  std::vector<int> children = graph_->GetNeighbors(start);
+  int start_index = graph_->ToInternal(start);
+  std::vector<int> children = graph_->GetNeighbors(start_index);
   if (children.empty()) {
     return result;
   }
@@ -93,10 +98,10 @@ SearchResult BFS::Search(int start, int goal) {
     std::uniform_int_distribution<> dis(0, children.size() - 1);
     int random_child = children[dis(gen)];
     
-    SearchResult attempt_result = BFS_From_Node(random_child, goal);
+    SearchResult attempt_result = BFS_From_Node(graph_->ToExternal(random_child), goal);
     if (attempt_result.path_found) {
       attempt_result.path.insert(attempt_result.path.begin(), start);
-      attempt_result.total_cost += graph_->GetEdgeCost(start, random_child);
+      attempt_result.total_cost += graph_->GetEdgeCost(start_index, random_child);
       return attempt_result;
     }
   }
@@ -2,19 +2,14 @@
 #define BFS_H
 
 #include "search_algorithm.h"
-#include <queue>
-#include <set>
 
 // Implementación de búsqueda en amplitud (BFS)
 class BFS : public SearchAlgorithm {
   public:
-    BFS(const Graph* graph);
+    BFS(const Graph* graph, TraceLevel trace = TraceLevel::kFull);
     SearchResult Search(int start, int goal) override;
     std::string GetAlgorithmName() const override;
   private:
-    std::queue<std::shared_ptr<Node>> frontier_;  // Cola de nodos por explorar
-    std::set<int> explored_;                      // Conjunto de nodos ya explorados
-    
     // Función auxiliar para BFS desde cualquier nodo
     SearchResult BFS_From_Node(int start, int goal);
 };
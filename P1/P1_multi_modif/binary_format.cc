@@ -0,0 +1,146 @@
+#include "binary_format.h"
+#include "mapped_file.h"
+#include <cstring>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const uint64_t kHashSeed = 0xcbf29ce484222325ULL;
+
+// Mezcla de 64 bits (FNV-1a por palabras con avalancha final de splitmix64)
+uint64_t HashBytes(const char* data, std::size_t size, uint64_t hash) {
+  const uint64_t kPrime = 0x100000001b3ULL;
+  std::size_t k = 0;
+  for (; k + 8 <= size; k += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + k, 8);
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; k < size; ++k) {
+    hash = (hash ^ static_cast<unsigned char>(data[k])) * kPrime;
+  }
+  
+  hash ^= hash >> 30;
+  hash *= 0xbf58476d1ce4e5b9ULL;
+  hash ^= hash >> 27;
+  hash *= 0x94d049bb133111ebULL;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+}  // namespace
+
+uint64_t BinaryChecksum(const char* data, std::size_t size) {
+  return HashBytes(data, size, kHashSeed);
+}
+
+// Rellena el tamaño y la fecha de modificación del fichero (no su hash)
+bool GetFileStamp(const std::string& filename, BinarySourceKey& key) {
+  struct stat info;
+  if (stat(filename.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+  
+  key.size = static_cast<uint64_t>(info.st_size);
+  key.mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+  key.hash = 0;
+  return true;
+}
+
+// Reescribe en la cabecera del fichero binario la clave de su fichero de origen
+bool UpdateBinarySourceKey(const std::string& filename, const BinarySourceKey& key) {
+  int fd = open(filename.c_str(), O_WRONLY);
+  if (fd < 0) {
+    return false;
+  }
+  
+  ssize_t written = pwrite(fd, &key, sizeof(key), offsetof(BinaryGraphHeader, source));
+  close(fd);
+  return written == static_cast<ssize_t>(sizeof(key));
+}
+
+bool HasBinaryGraphMagic(const char* data, std::size_t size) {
+  return size >= sizeof(kBinaryGraphMagic) &&
+         std::memcmp(data, kBinaryGraphMagic, sizeof(kBinaryGraphMagic)) == 0;
+}
+
+// Comprueba que la cabecera es de esta versión y que las secciones caben en el fichero
+bool ValidateBinaryGraphHeader(const BinaryGraphHeader& header, std::size_t file_size, std::string& error) {
+  if (file_size < sizeof(BinaryGraphHeader)) {
+    error = "cabecera incompleta";
+    return false;
+  }
+  if (!HasBinaryGraphMagic(header.magic, sizeof(header.magic))) {
+    error = "no es un fichero binario de grafo";
+    return false;
+  }
+  if (header.version != kBinaryGraphVersion) {
+    error = "versión de formato no soportada";
+    return false;
+  }
+  if (header.byte_order != kBinaryByteOrderMark) {
+    error = "orden de bytes distinto al de esta máquina";
+    return false;
+  }
+  if (header.num_vertices <= 0) {
+    error = "número de vértices inválido";
+    return false;
+  }
+  
+  for (int s = 0; s < kNumBinarySections; ++s) {
+    if (header.section_bytes[s] == 0) {
+      continue;
+    }
+    if (header.section_offset[s] % kBinarySectionAlignment != 0 ||
+        header.section_offset[s] > file_size ||
+        header.section_bytes[s] > file_size - header.section_offset[s]) {
+      error = "sección fuera del fichero";
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+// Suma de comprobación de las kNumBinarySections secciones, en orden
+uint64_t BinarySectionsChecksum(const char* const sections[], const uint64_t section_bytes[]) {
+  uint64_t hash = kHashSeed;
+  for (int s = 0; s < kNumBinarySections; ++s) {
+    hash = HashBytes(sections[s], section_bytes[s], hash);
+  }
+  return hash;
+}
+
+// Lee el fichero completo y compara su suma de comprobación con la de la cabecera
+bool VerifyBinaryGraphFile(const std::string& filename, std::string& error) {
+  MappedFile file;
+  if (!file.Open(filename)) {
+    error = "no se pudo abrir el archivo";
+    return false;
+  }
+  file.AdviseSequential();
+  
+  BinaryGraphHeader header;
+  if (file.Size() < sizeof(header)) {
+    error = "cabecera incompleta";
+    return false;
+  }
+  std::memcpy(&header, file.Data(), sizeof(header));
+  
+  if (!ValidateBinaryGraphHeader(header, file.Size(), error)) {
+    return false;
+  }
+  const char* sections[kNumBinarySections];
+  for (int s = 0; s < kNumBinarySections; ++s) {
+    sections[s] = file.Data() + header.section_offset[s];
+  }
+  if (BinarySectionsChecksum(sections, header.section_bytes) != header.checksum) {
+    error = "la suma de comprobación no coincide";
+    return false;
+  }
+  
+  return true;
+}
@@ -1,6 +1,6 @@
 #include "dfs.h"
 
-DFS::DFS(const Graph* graph) : SearchAlgorithm(graph) {}
+DFS::DFS(const Graph* graph, TraceLevel trace) : SearchAlgorithm(graph, trace) {}
 
 std::string DFS::GetAlgorithmName() const {
   return "DFS";
@@ -9,56 +9,67 @@ std::string DFS::GetAlgorithmName() const {
 SearchResult DFS::Search(int start, int goal) {
   // Reiniciar estructuras
   Reset();
-  while (!frontier_.empty()) {
-    frontier_.pop();
-  }
-  explored_.clear();
+  frontier_.clear();
   
   SearchResult result;
   
-  if (!graph_->IsValidVertex(start) || !graph_->IsValidVertex(goal)) {
+  if (!graph_->IsValidVertex(start) || (goal != kNoGoal && !graph_->IsValidVertex(goal))) {
+    return result;
+  }
+  
+  // La búsqueda trabaja con la numeración interna del grafo
+  start = graph_->ToInternal(start);
+  goal = graph_->ToInternal(goal);
+  
+  // Sin camino posible no hace falta explorar la componente del origen
+  if (goal != kNoGoal && !graph_->SameComponent(start, goal)) {
+    result.unreachable = true;
+    FinishResult(result);
     return result;
   }
   
-  std::shared_ptr<Node> start_node = std::make_shared<Node>(start);
-  frontier_.push(start_node);
+  frontier_.push_back(nodes_.Add(start, Node::kNoParent, 0.0));
   MarkNodeGenerated(start);
   
   AddIteration();
   
   while (!frontier_.empty()) {
-    std::shared_ptr<Node> current_node = frontier_.top();
-    frontier_.pop();
+    int current_node = frontier_.back();
+    frontier_.pop_back();
     
-    int current_vertex = current_node->GetVertex();
+    // Copias: añadir vecinos al arena puede mover sus nodos
+    int current_vertex = nodes_[current_node].GetVertex();
+    double current_cost = nodes_[current_node].GetPathCost();
     
-    if (explored_.find(current_vertex) != explored_.end()) {
+    if (explored_.Contains(current_vertex)) {
       continue;
     }
     
-    explored_.insert(current_vertex);
+    explored_.Insert(current_vertex);
     MarkNodeInspected(current_vertex);
     
     if (current_vertex == goal) {
       result.path_found = true;
       result.path = ReconstructPath(current_node);
       result.total_cost = CalculatePathCost(result.path);
-      result.iterations = iterations_;
+      FinishResult(result);
       return result;
     }
     
-    std::vector<int> neighbors = graph_->GetNeighbors(current_vertex);
-    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
-      int neighbor = *it;
+    // Los vecinos se apilan en orden inverso para expandir primero el menor.
+    // neighbor_buffer_ se reutiliza entre expansiones y no vuelve a reservar
+    neighbor_buffer_.clear();
+    graph_->ForEachNeighbor(current_vertex, [this](int neighbor, double edge_cost) {
+      neighbor_buffer_.push_back(std::make_pair(neighbor, edge_cost));
+    });
+    
+    for (auto it = neighbor_buffer_.rbegin(); it != neighbor_buffer_.rend(); ++it) {
+      int neighbor = it->first;
       // Solo generar y añadir a la frontera si no ha sido explorado
-      if (explored_.find(neighbor) == explored_.end()) {
+      if (!explored_.Contains(neighbor)) {
         MarkNodeGenerated(neighbor);
         
-        double edge_cost = graph_->GetEdgeCost(current_vertex, neighbor);
-        double new_path_cost = current_node->GetPathCost() + edge_cost;
-        
-        std::shared_ptr<Node> neighbor_node = std::make_shared<Node>(neighbor, current_node, new_path_cost);
-        frontier_.push(neighbor_node);
+        frontier_.push_back(nodes_.Add(neighbor, current_node, current_cost + it->second));
       }
     }
     
@@ -66,6 +77,6 @@ SearchResult DFS::Search(int start, int goal) {
   }
   
   // No se encontró camino
-  result.iterations = iterations_;
+  FinishResult(result);
   return result;
 }
\ No newline at end of file
@@ -2,19 +2,18 @@
 #define DFS_H
 
 #include "search_algorithm.h"
-#include <stack>
-#include <set>
+#include <utility>
 
 // Implementación de búsqueda en profundidad (DFS)
 class DFS : public SearchAlgorithm {
   public:
-    DFS(const Graph* graph);
+    DFS(const Graph* graph, TraceLevel trace = TraceLevel::kFull);
     SearchResult Search(int start, int goal) override;
     std::string GetAlgorithmName() const override;
 
   private:
-    std::stack<std::shared_ptr<Node>> frontier_;  // Pila de nodos por explorar
-    std::set<int> explored_;                      // Conjunto de nodos ya explorados
+    std::vector<int> frontier_;                   // Pila de nodos por explorar (posiciones en nodes_)
+    std::vector<std::pair<int, double>> neighbor_buffer_;  // Vecinos (y coste) del nodo expandido
 };
 
 #endif
\ No newline at end of file
@@ -4,34 +4,514 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <ostream>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include "graph_array.h"
+#include "mapped_file.h"
+#include "binary_format.h"
+#include "compressed_row.h"
+#include "lazy_triangle.h"
+
+// Representación interna de la adyacencia
+enum class GraphStorage {
+  kCsr,             // Listas compactas (CSR): memoria O(V + E), para grafos dispersos
+  kPackedTriangle,  // Triángulo superior empaquetado de float: para grafos densos
+  kBitset,          // Triángulo empaquetado + mapa de bits de adyacencia por vértice
+  kCompressed,      // CSR con vecinos en diferencias y costes cuantizados, en varint (solo lectura)
+  kLazy,            // Triángulo de texto leído bajo demanda, con una caché de filas (solo lectura)
+  kAuto             // Solo al cargar: se elige una de las anteriores según la densidad (ver ChooseStorage)
+};
+
+// Formato del fichero de entrada
+enum class GraphFileFormat {
+  kAuto,       // Según la extensión (.gr DIMACS, .el/.edges lista de aristas) o triángulo
+  kTriangle,   // Número de vértices y triángulo superior de distancias (formato del problema)
+  kEdgeList,   // Una arista "u v [coste]" por línea, vértices 1-index
+  kDimacs      // Grafo .gr del 9th DIMACS Implementation Challenge (líneas "p sp" y "a u v w")
+};
+
+// Renumeración de los vértices al cargar, para que los vecinos queden cerca en memoria
+enum class GraphReorder {
+  kNone,       // Orden del fichero
+  kRcm,        // Reverse Cuthill-McKee: recorrido en anchura por grado creciente, invertido
+  kDegree      // Grado decreciente: los vértices más conectados juntos al principio
+};
+
+// Opciones de carga de un grafo
+struct GraphLoadOptions {
+  GraphStorage storage;     // Representación con la que se cargan los ficheros de texto (kAuto: según densidad)
+  GraphFileFormat format;   // Formato de los ficheros de texto (los binarios se detectan solos)
+  GraphReorder reorder;     // Renumeración de los vértices (solo en la representación CSR)
+  bool use_snapshot;        // Reutilizar (o crear) una instantánea binaria junto al fichero de texto
+  std::string shared_name;  // Segmento de memoria compartida del que se toma o en que se publica (vacío: ninguno)
+  GraphMemory memory;       // Páginas grandes y ubicación NUMA de los arrays (graph_memory.h)
+  bool quantize_weights;    // Guardar los costes CSR como enteros de 16/32 bits si no se pierde precisión
+  std::size_t lazy_cache_entries;  // Vecinos decodificados que conserva kLazy (ver LazyTriangle)
+  
+  GraphLoadOptions()
+    : storage(GraphStorage::kAuto), format(GraphFileFormat::kAuto), reorder(GraphReorder::kNone),
+      use_snapshot(true), memory(GraphMemory::kDefault),
+      quantize_weights(false), lazy_cache_entries(kDefaultLazyCacheEntries) {}
+};
+
+// Ventana de la matriz de adyacencia que se vuelca con Graph::WriteMatrix.
+// Filas y columnas en la numeración del fichero (1-index), ambos extremos
+// incluidos; un extremo final de 0 llega hasta el último vértice
+struct MatrixWindow {
+  int first_row;
+  int last_row;
+  int first_column;
+  int last_column;
+  bool edges_only;          // Solo las aristas existentes, una "fila columna coste" por línea
+  
+  MatrixWindow() : first_row(1), last_row(0), first_column(1), last_column(0), edges_only(false) {}
+};
+
+// Estadísticas de la adyacencia con las que se elige la representación
+struct GraphStats {
+  double density;                     // Aristas / pares de vértices posibles
+  double average_degree;
+  int min_degree;
+  int max_degree;
+  std::vector<long long> degree_histogram;  // Vértices con grado 0 (posición 0) y en [2^(b-1), 2^b) (posición b)
+  bool float_exact;                   // Todos los costes caben sin pérdida en float (packed, bitset)
+  
+  GraphStats() : density(0.0), average_degree(0.0), min_degree(0), max_degree(0), float_exact(true) {}
+};
+
+// Arista no dirigida (índices 0-based, from < to)
+struct GraphEdge {
+  int from;
+  int to;
+  double cost;
+};
+
+std::string GraphStorageName(GraphStorage storage);
+bool ParseGraphStorage(const std::string& name, GraphStorage& storage);
+bool ParseGraphFileFormat(const std::string& name, GraphFileFormat& format);
+std::string GraphReorderName(GraphReorder reorder);
+bool ParseGraphReorder(const std::string& name, GraphReorder& reorder);
+bool ParseGraphLoadOption(const std::string& option, GraphLoadOptions& options);
 
 /**
- * @brief Clase que representa un grafo con matriz de adyacencia
+ * @brief Clase que representa un grafo con listas de adyacencia compactas (CSR)
  * 
  * Esta clase maneja un grafo no dirigido con pesos en las aristas.
  * Lee el formato específico del problema y proporciona métodos para
- * acceder a la información del grafo.
+ * acceder a la información del grafo. Por defecto guarda solo las aristas
+ * existentes en formato CSR (compressed sparse row), de modo que recorrer
+ * los vecinos de un vértice cuesta O(grado) y la memoria es O(V + E).
+ * Para grafos densos puede guardar en su lugar el triángulo superior en un
+ * único array contiguo de V(V-1)/2 float, opcionalmente acompañado de un
+ * mapa de bits por vértice (64 vecinos por palabra) para enumerar vecinos
+ * en O(V/64).
+ *
+ * Además del triángulo de distancias acepta listas de aristas y grafos .gr
+ * de DIMACS (graph_formats.h), que se cargan sin pasar por la matriz.
+ * También puede leer y escribir un formato binario
+ * (binary_format.h) que se abre con mmap y se usa sin parsear ni copiar.
+ * Al cargar un fichero de texto se guarda una instantánea binaria a su lado
+ * (<fichero>.<representación>.snapshot) que se reutiliza en las siguientes
+ * cargas mientras el fichero de texto no cambie. El mismo formato sirve para
+ * compartir un grafo entre procesos: uno lo publica en un segmento de memoria
+ * compartida POSIX (PublishShared) y los demás se adjuntan en O(1)
+ * (AttachShared), así que la memoria total no crece con cada proceso.
+ *
+ * En CSR los vértices pueden renumerarse al cargar (GraphReorder) para que
+ * los vecinos de cada vértice queden cerca en memoria. Todos los métodos
+ * trabajan entonces con la numeración interna; ToInternal y ToExternal
+ * convierten desde y hacia los números del fichero. Cada fila sigue
+ * ordenada por número original, así que los vecinos se recorren en el mismo
+ * orden que sin reordenar.
+ *
+ * Al cargar se etiqueta la componente conexa de cada vértice, de modo que
+ * las búsquedas pueden descartar en O(1) los pares sin camino posible.
+ *
+ * Las aristas se pueden modificar sin recargar el fichero (SetEdgeCost,
+ * RemoveEdge). En las representaciones densas el cambio es directo; en CSR
+ * se anota en un buffer de modificaciones por fila que ForEachNeighbor
+ * mezcla con la fila al recorrerla, y que se vuelca a los arrays CSR
+ * (Compact) cuando crece demasiado. El número de aristas se mantiene al día
+ * tras cada modificación; las componentes conexas se vuelven a etiquetar una
+ * sola vez, en la primera consulta (SameComponent) tras modificar.
+ *
+ * Para grafos dispersos muy grandes la representación kCompressed guarda
+ * cada fila CSR como una secuencia de bytes (compressed_row.h): vecinos en
+ * diferencias y costes como enteros de coste * 10^weight_decimals_ cuando
+ * eso no pierde precisión (los costes leídos con pocos decimales), o como
+ * double en caso contrario. Ocupa varias veces menos que CSR a cambio de
+ * decodificar la fila al recorrerla, y no admite modificaciones. Con
+ * GraphLoadOptions::quantize_weights la representación CSR hace lo mismo
+ * solo con los costes: los guarda en 16 o 32 bits en lugar de double si el
+ * número de decimales detectado al cargar los reproduce exactamente.
+ *
+ * Por defecto (GraphStorage::kAuto) la representación se elige al cargar
+ * a partir de la densidad y el histograma de grados (ChooseStorage): el
+ * triángulo empaquetado o el mapa de bits para grafos densos cuyos costes
+ * caben sin pérdida en float, y CSR en los demás casos. GetStats y
+ * GetStorage permiten comprobar qué se eligió.
+ *
+ * Para consultar unos pocos pares de un triángulo de texto demasiado grande
+ * para cargarlo entero, GraphStorage::kLazy deja el fichero proyectado y
+ * solo construye un índice disperso de posiciones (LazyTriangle): cada fila
+ * se decodifica la primera vez que se recorre y se guarda en una caché de
+ * tamaño limitado. No admite modificaciones, reordenación, instantáneas ni
+ * etiquetado de componentes (que obligaría a leer todo el fichero).
+ *
+ * Con GraphLoadOptions::memory los arrays grandes se mueven tras la carga a
+ * regiones con páginas grandes, repartidas entre los nodos NUMA si se pide
+ * (graph_memory.h). Los arrays de un fichero binario se copian entonces a
+ * esas regiones en lugar de usarse desde la proyección.
  */
 class Graph {
   public:
     Graph();
-    Graph(const std::string& filename);
+    Graph(const std::string& filename, const GraphLoadOptions& options = GraphLoadOptions());
     ~Graph();
-    bool LoadFromFile(const std::string& filename);
+    bool LoadFromFile(const std::string& filename, const GraphLoadOptions& options = GraphLoadOptions());
+    bool LoadFromEdges(int num_vertices, std::vector<GraphEdge>& edges,
+                       GraphStorage storage = GraphStorage::kCsr);
+    bool SaveBinary(const std::string& filename);
+    bool PublishShared(const std::string& name);
+    bool AttachShared(const std::string& name);
+    static bool RemoveShared(const std::string& name);
+    GraphStorage GetStorage() const;
+    bool IsStorageAutomatic() const;
+    const GraphStats& GetStats() const;
+    static GraphStorage ChooseStorage(const GraphStats& stats);
+    int GetWeightBytes() const;
+    int GetWeightDecimals() const;
+    const LazyTriangle& GetLazyRows() const;
     int GetNumVertices() const;
     int GetNumEdges() const;
     double GetEdgeCost(int from, int to) const;
     bool HasEdge(int from, int to) const;
     std::vector<int> GetNeighbors(int vertex) const;
+    template <typename Visitor>
+    void ForEachNeighbor(int vertex, Visitor visit) const;
     bool IsValidVertex(int vertex) const;
+    int ToInternal(int vertex) const;
+    int ToExternal(int vertex) const;
+    int GetComponent(int vertex) const;
+    bool SameComponent(int from, int to) const;
     std::string ToString() const;
     void PrintMatrix() const;
+    void WriteMatrix(std::ostream& out, const MatrixWindow& window = MatrixWindow()) const;
     void CalculateEdges();
+    bool SetEdgeCost(int from, int to, double cost);
+    bool RemoveEdge(int from, int to);
+    void Compact();
 
   private:
+    // Modificación pendiente de una fila CSR: nuevo coste de la arista con
+    // neighbor (0-based) o, si cost es negativo, arista eliminada
+    struct EdgeDelta {
+      int neighbor;
+      double cost;
+    };
+    
+    // Trozo del triángulo de distancias que se parsea de forma independiente
+    struct ParseChunk {
+      const char* begin;
+      const char* end;
+      std::size_t first_token;    // Posición en el triángulo del primer valor del trozo
+      std::size_t num_tokens;     // Valores del triángulo que contiene el trozo
+      std::size_t failed_token;   // Posición del valor que no se pudo leer
+      std::vector<GraphEdge> edges;    // Aristas encontradas (modo CSR)
+    };
+    
+    bool LoadText(GraphStorage storage);
+    bool LoadLazyText(std::size_t cache_entries);
+    bool LoadSparseText(const std::string& filename, GraphStorage storage, GraphFileFormat format);
+    void BuildFromEdges(int num_vertices, std::vector<GraphEdge>& edges, GraphStorage storage);
+    bool LoadShared(const std::string& filename, const GraphLoadOptions& options);
+    bool LoadBinary(std::string& error);
+    bool ValidateSections() const;
+    bool LoadSnapshot(const std::string& filename, const std::string& snapshot_file,
+                      GraphStorage storage, const BinarySourceKey& key);
+    void WriteSnapshot(const std::string& snapshot_file, const BinarySourceKey& key) const;
+    uint64_t LayoutBinary(const BinarySourceKey& source, BinaryGraphHeader& header, const char* sections[]) const;
+    bool WriteBinary(const std::string& filename, const BinarySourceKey& source) const;
+    void PrepareStorage();
+    void PlaceArrays();
+    bool ParseDistances(ParseChunk& chunk, bool check_token_bounds);
+    bool ParseDistancesParallel(const char* begin, const char* end, std::vector<GraphEdge>& edges);
+    std::size_t TriangleSize() const;
+    void TriangleCoordinates(std::size_t token, int& from_index, int& to_index) const;
+    void BuildStorage(const std::vector<GraphEdge>& edges);
+    void ComputeStats(const std::vector<GraphEdge>& edges) const;
+    void ComputeStats() const;
+    void FinishStats(const std::vector<int>& degrees, long long edges, bool float_exact) const;
+    void BuildCsr(const std::vector<GraphEdge>& edges);
+    void CompressRows();
+    void QuantizeWeights();
+    double CsrWeight(uint64_t k) const;
+    void Reorder(GraphReorder reorder);
+    std::vector<int> ComputeOrder(GraphReorder reorder) const;
+    void LabelComponents() const;
+    void MakeMutable();
+    void SetDelta(int from_index, int to_index, double cost);
+    void CompactIfNeeded();
+    const EdgeDelta* FindDelta(int from_index, int to_index) const;
+    int RowKey(int index) const;
+    void ClearAdjacencyBit(int from_index, int to_index);
+    long FindEdge(int from_index, int to_index) const;
+    std::size_t PackedIndex(int from_index, int to_index) const;
+    bool UsesPackedTriangle() const;
+    void SetAdjacencyBit(int from_index, int to_index);
+    bool TestAdjacencyBit(int from_index, int to_index) const;
+    
     int num_vertices_;
-    std::vector<std::vector<double>> matrix_;
+    GraphStorage storage_;
+    GraphArray<uint64_t> offsets_;      // Inicio de la fila de cada vértice (tamaño V + 1)
+    GraphArray<int> adjacency_;         // Vecinos (0-based) de cada fila, en orden creciente
+    GraphArray<double> weights_;        // Coste de la arista correspondiente en adjacency_
+    GraphArray<uint16_t> weights16_;    // Costes cuantizados en 16 bits (en lugar de weights_)
+    GraphArray<uint32_t> weights32_;    // Costes cuantizados en 32 bits (en lugar de weights_)
+    GraphArray<float> packed_;          // Triángulo superior por filas (kPackedTriangle, kBitset)
+    GraphArray<uint64_t> bitmap_;       // Fila de bits de adyacencia de cada vértice (kBitset)
+    std::size_t words_per_row_;         // Palabras de 64 bits por fila de bitmap_
+    GraphArray<uint8_t> compressed_;    // Filas codificadas (kCompressed); offsets_ da el byte de inicio
+    LazyTriangle lazy_;                 // Índice y caché de filas del texto proyectado (kLazy)
+    int weight_decimals_;               // Costes cuantizados como enteros * 10^-d (-1: double)
+    GraphMemory memory_;                // Ubicación de los arrays propios (ver PlaceArrays)
+    bool storage_automatic_;            // storage_ se eligió con ChooseStorage
+    mutable GraphStats stats_;          // Estadísticas de la adyacencia (ver GetStats)
+    mutable bool stats_valid_;          // stats_ corresponde al grafo actual
+    bool quantize_weights_;             // Volver a cuantizar los costes CSR al compactar
+    GraphArray<int> external_ids_;      // Número original (0-based) de cada vértice interno
+    GraphArray<int> internal_ids_;      // Vértice interno de cada número original
+    mutable GraphArray<int> components_;  // Componente conexa (0, 1, ...) de cada vértice interno
+    bool components_stale_;             // Las componentes no están etiquetadas (kLazy)
+    mutable bool components_dirty_;     // Hay que volver a etiquetar tras modificar aristas
+    std::vector<std::vector<EdgeDelta>> deltas_;  // Modificaciones de cada fila CSR, en orden de RowKey
+    std::size_t num_deltas_;            // Entradas en deltas_ (contando ambos extremos)
+    long long delta_entries_;           // Extremos de arista que añaden (o quitan) las entradas de deltas_
+    MappedFile mapping_;                // Fichero binario, segmento compartido o texto (kLazy) del que se leen los datos
     int num_edges_;
 };
 
-#endif
\ No newline at end of file
+// Número interno (1-index) del vértice vertex del fichero. Los valores que no
+// son vértices, como SearchAlgorithm::kNoGoal, se devuelven sin cambios
+inline int Graph::ToInternal(int vertex) const {
+  if (internal_ids_.Empty() || vertex < 1 || vertex > num_vertices_) {
+    return vertex;
+  }
+  return internal_ids_[vertex - 1] + 1;
+}
+
+// Número del fichero (1-index) del vértice interno vertex
+inline int Graph::ToExternal(int vertex) const {
+  if (external_ids_.Empty() || vertex < 1 || vertex > num_vertices_) {
+    return vertex;
+  }
+  return external_ids_[vertex - 1] + 1;
+}
+
+// Clave por la que se ordena cada fila CSR: el número original del vecino
+inline int Graph::RowKey(int index) const {
+  return external_ids_.Empty() ? index : external_ids_[index];
+}
+
+// Componente conexa del vértice (-1 si no es válido o no se etiquetaron).
+// Tras modificar aristas la primera consulta vuelve a etiquetar el grafo
+inline int Graph::GetComponent(int vertex) const {
+  if (components_dirty_) {
+    LabelComponents();
+  }
+  if (vertex < 1 || vertex > num_vertices_ || components_.Empty()) {
+    return -1;
+  }
+  return components_[vertex - 1];
+}
+
+// Indica si puede haber algún camino entre los dos vértices. Si no hay
+// etiquetas (kLazy) no se descarta ningún par
+inline bool Graph::SameComponent(int from, int to) const {
+  if (components_stale_) {
+    return IsValidVertex(from) && IsValidVertex(to);
+  }
+  
+  int component = GetComponent(from);
+  return component >= 0 && component == GetComponent(to);
+}
+
+// Coste de la entrada k de las filas CSR, decodificado si está cuantizado
+inline double Graph::CsrWeight(uint64_t k) const {
+  if (weight_decimals_ < 0) {
+    return weights_[k];
+  }
+  double quantized = weights16_.Empty() ? weights32_[k] : weights16_[k];
+  return quantized / DecimalScale(weight_decimals_);
+}
+
+// Posición de la arista {from_index, to_index} en el triángulo empaquetado.
+// La fila i ocupa las posiciones de los pares (i, i+1) ... (i, V-1)
+inline std::size_t Graph::PackedIndex(int from_index, int to_index) const {
+  if (from_index > to_index) {
+    std::swap(from_index, to_index);
+  }
+  
+  std::size_t i = static_cast<std::size_t>(from_index);
+  std::size_t n = static_cast<std::size_t>(num_vertices_);
+  return i * (2 * n - i - 1) / 2 + (to_index - from_index - 1);
+}
+
+/**
+ * @brief Recorre los vecinos de un vértice en orden creciente sin reservar memoria
+ *
+ * Llama a visit(vecino, coste) por cada arista del vértice, obteniendo el
+ * coste en la misma pasada que el vecino. No hace nada si el vértice no es
+ * válido.
+ */
+template <typename Visitor>
+void Graph::ForEachNeighbor(int vertex, Visitor visit) const {
+  if (!IsValidVertex(vertex)) {
+    return;
+  }
+  
+  int vertex_index = vertex - 1;
+  
+  if (storage_ == GraphStorage::kCsr) {
+    const int* adjacency = adjacency_.Data();
+    const double* weights = weights_.Data();
+    uint64_t k = offsets_[vertex_index];
+    uint64_t last = offsets_[vertex_index + 1];
+    if (deltas_.empty() || deltas_[vertex_index].empty()) {
+      if (weight_decimals_ < 0) {
+        for (; k < last; ++k) {
+          visit(adjacency[k] + 1, weights[k]);
+        }
+      } else if (!weights16_.Empty()) {
+        const uint16_t* quantized = weights16_.Data();
+        double scale = DecimalScale(weight_decimals_);
+        for (; k < last; ++k) {
+          visit(adjacency[k] + 1, static_cast<double>(quantized[k]) / scale);
+        }
+      } else {
+        const uint32_t* quantized = weights32_.Data();
+        double scale = DecimalScale(weight_decimals_);
+        for (; k < last; ++k) {
+          visit(adjacency[k] + 1, static_cast<double>(quantized[k]) / scale);
+        }
+      }
+      return;
+    }
+    
+    // Mezcla la fila con sus modificaciones pendientes, ambas en orden de RowKey
+    const std::vector<EdgeDelta>& deltas = deltas_[vertex_index];
+    std::size_t d = 0;
+    while (k < last || d < deltas.size()) {
+      if (d == deltas.size() || (k < last && RowKey(adjacency[k]) < RowKey(deltas[d].neighbor))) {
+        visit(adjacency[k] + 1, CsrWeight(k));
+        ++k;
+        continue;
+      }
+      
+      // La modificación sustituye a la arista de la fila, si existía
+      if (k < last && adjacency[k] == deltas[d].neighbor) {
+        ++k;
+      }
+      if (deltas[d].cost >= 0) {
+        visit(deltas[d].neighbor + 1, deltas[d].cost);
+      }
+      ++d;
+    }
+    return;
+  }
+  
+  if (storage_ == GraphStorage::kBitset) {
+    // Recorrido por palabras: cada bit activo es un vecino (tzcnt)
+    const uint64_t* row = bitmap_.Data() + vertex_index * words_per_row_;
+    const float* packed = packed_.Data();
+    std::size_t word = 0;
+#ifdef __AVX2__
+    // Saltar bloques de 256 bits sin vecinos con una sola comprobación
+    for (; word + 4 <= words_per_row_; word += 4) {
+      __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + word));
+      if (_mm256_testz_si256(block, block)) {
+        continue;
+      }
+      for (std::size_t k = word; k < word + 4; ++k) {
+        for (uint64_t bits = row[k]; bits != 0; bits &= bits - 1) {
+          int neighbor_index = static_cast<int>(k * 64 + __builtin_ctzll(bits));
+          visit(neighbor_index + 1, static_cast<double>(packed[PackedIndex(vertex_index, neighbor_index)]));
+        }
+      }
+    }
+#endif
+    for (; word < words_per_row_; ++word) {
+      for (uint64_t bits = row[word]; bits != 0; bits &= bits - 1) {
+        int neighbor_index = static_cast<int>(word * 64 + __builtin_ctzll(bits));
+        visit(neighbor_index + 1, static_cast<double>(packed[PackedIndex(vertex_index, neighbor_index)]));
+      }
+    }
+    return;
+  }
+  
+  if (storage_ == GraphStorage::kLazy) {
+    // La fila se conserva aunque visit provoque su expulsión de la caché
+    std::shared_ptr<const LazyRow> row = lazy_.Row(vertex_index);
+    for (const LazyEntry& entry : *row) {
+      visit(entry.neighbor + 1, entry.cost);
+    }
+    return;
+  }
+  
+  if (storage_ == GraphStorage::kCompressed) {
+    const uint8_t* bytes = compressed_.Data() + offsets_[vertex_index];
+    const uint8_t* end = compressed_.Data() + offsets_[vertex_index + 1];
+    double scale = weight_decimals_ >= 0 ? DecimalScale(weight_decimals_) : 1.0;
+    int neighbor_index = vertex_index;
+    bool first = true;
+    while (bytes < end) {
+      uint64_t gap;
+      bytes = ReadVarint(bytes, gap);
+      if (first) {
+        neighbor_index += static_cast<int>(ZigZagDecode(gap));
+        first = false;
+      } else {
+        neighbor_index += static_cast<int>(gap) + 1;
+      }
+      
+      double cost;
+      if (weight_decimals_ >= 0) {
+        uint64_t quantized;
+        bytes = ReadVarint(bytes, quantized);
+        cost = static_cast<double>(quantized) / scale;
+      } else {
+        std::memcpy(&cost, bytes, sizeof(cost));
+        bytes += sizeof(cost);
+      }
+      visit(neighbor_index + 1, cost);
+    }
+    return;
+  }
+  
+  // kPackedTriangle: columna vertex_index de las filas anteriores y después su propia fila
+  const float* packed = packed_.Data();
+  for (int i = 0; i < vertex_index; ++i) {
+    float cost = packed[PackedIndex(i, vertex_index)];
+    if (cost >= 0) {
+      visit(i + 1, static_cast<double>(cost));
+    }
+  }
+  
+  if (vertex_index + 1 < num_vertices_) {
+    const float* row = packed + PackedIndex(vertex_index, vertex_index + 1);
+    for (int j = vertex_index + 1; j < num_vertices_; ++j) {
+      float cost = row[j - vertex_index - 1];
+      if (cost >= 0) {
+        visit(j + 1, static_cast<double>(cost));
+      }
+    }
+  }
+}
+
+#endif
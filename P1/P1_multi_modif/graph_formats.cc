@@ -0,0 +1,312 @@
+#include "graph_formats.h"
+#include "text_scanner.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+// Llama a visit(línea, scanner) con cada línea de [begin, end) que no esté
+// vacía. El scanner solo ve la línea, así que los números de otra línea no
+// se confunden con campos opcionales. Se detiene si visit devuelve false
+template <typename Visitor>
+bool ForEachLine(const char* begin, const char* end, Visitor visit) {
+  int line = 0;
+  const char* line_begin = begin;
+  while (line_begin < end) {
+    const void* newline = std::memchr(line_begin, '\n', end - line_begin);
+    const char* line_end = newline != nullptr ? static_cast<const char*>(newline) : end;
+    ++line;
+    
+    TextScanner scanner(line_begin, line_end);
+    if (!scanner.AtEnd() && !visit(line, scanner)) {
+      return false;
+    }
+    line_begin = line_end + 1;
+  }
+  return true;
+}
+
+std::string LineError(int line, const std::string& message) {
+  return "línea " + std::to_string(line) + ": " + message;
+}
+
+// Escritura de texto por bloques: los ficheros de grafos grandes tienen
+// cientos de millones de números
+class TextWriter {
+  public:
+    explicit TextWriter(const std::string& filename) : file_(filename.c_str(), std::ios::binary | std::ios::trunc) {}
+    
+    bool IsOpen() const {
+      return file_.is_open();
+    }
+    
+    void Append(const char* text) {
+      buffer_ += text;
+      if (buffer_.size() >= kFlushBytes) {
+        Flush();
+      }
+    }
+    
+    void AppendNumber(double value, int decimals) {
+      char number[64];
+      std::snprintf(number, sizeof(number), "%.*f", decimals, value);
+      Append(number);
+    }
+    
+    void AppendInt(long long value) {
+      char number[32];
+      std::snprintf(number, sizeof(number), "%lld", value);
+      Append(number);
+    }
+    
+    // Vuelca lo pendiente y cierra el fichero. Devuelve false si algo falló
+    bool Close() {
+      Flush();
+      file_.close();
+      return !file_.fail();
+    }
+  
+  private:
+    static const std::size_t kFlushBytes = 1 << 20;
+    
+    void Flush() {
+      file_.write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+    
+    std::ofstream file_;
+    std::string buffer_;
+};
+
+bool HasSuffix(const std::string& text, const std::string& suffix) {
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+// Formato que corresponde a la extensión del fichero (triángulo por defecto)
+GraphFileFormat DetectGraphFileFormat(const std::string& filename) {
+  if (HasSuffix(filename, ".gr")) {
+    return GraphFileFormat::kDimacs;
+  }
+  if (HasSuffix(filename, ".el") || HasSuffix(filename, ".edges")) {
+    return GraphFileFormat::kEdgeList;
+  }
+  return GraphFileFormat::kTriangle;
+}
+
+bool ReadEdgeList(const char* begin, const char* end, int& num_vertices,
+                  std::vector<GraphEdge>& edges, std::string& error) {
+  num_vertices = 0;
+  edges.clear();
+  
+  bool ok = ForEachLine(begin, end, [&](int line, TextScanner& scanner) {
+    char first = *scanner.Position();
+    if (first == '#' || first == '%') {
+      return true;
+    }
+    
+    int from, to;
+    if (!scanner.NextInt(from) || !scanner.NextInt(to) || from < 1 || to < 1) {
+      error = LineError(line, "se esperaba una arista \"u v [coste]\" con vértices 1-index");
+      return false;
+    }
+    
+    double cost = 1.0;
+    if (!scanner.AtEnd() && (!scanner.NextDistance(cost) || cost < 0)) {
+      error = LineError(line, "coste de arista inválido");
+      return false;
+    }
+    
+    GraphEdge edge = {from - 1, to - 1, cost};
+    edges.push_back(edge);
+    num_vertices = std::max(num_vertices, std::max(from, to));
+    return true;
+  });
+  
+  if (ok && num_vertices == 0) {
+    error = "el fichero no contiene aristas";
+    return false;
+  }
+  return ok;
+}
+
+bool ReadDimacsGraph(const char* begin, const char* end, int& num_vertices,
+                     std::vector<GraphEdge>& edges, std::string& error) {
+  num_vertices = 0;
+  edges.clear();
+  
+  bool ok = ForEachLine(begin, end, [&](int line, TextScanner& scanner) {
+    std::string kind = scanner.NextWord();
+    if (kind == "c") {
+      return true;
+    }
+    
+    if (kind == "p") {
+      int arcs;
+      if (num_vertices != 0 || scanner.NextWord() != "sp" || !scanner.NextInt(num_vertices) ||
+          !scanner.NextInt(arcs) || num_vertices <= 0 || arcs < 0) {
+        error = LineError(line, "se esperaba una única línea \"p sp <vértices> <arcos>\"");
+        return false;
+      }
+      // La cabecera puede mentir: cada arco ocupa al menos los 8 bytes de "a 1 2 0\n"
+      edges.reserve(std::min<std::size_t>(arcs, static_cast<std::size_t>(end - begin) / 8));
+      return true;
+    }
+    
+    if (kind == "a") {
+      int from, to;
+      double cost;
+      if (num_vertices == 0) {
+        error = LineError(line, "arco antes de la línea \"p sp\"");
+        return false;
+      }
+      if (!scanner.NextInt(from) || !scanner.NextInt(to) || !scanner.NextDistance(cost) ||
+          from < 1 || to < 1 || from > num_vertices || to > num_vertices || cost < 0) {
+        error = LineError(line, "se esperaba un arco \"a u v w\" entre vértices existentes");
+        return false;
+      }
+      GraphEdge edge = {from - 1, to - 1, cost};
+      edges.push_back(edge);
+      return true;
+    }
+    
+    error = LineError(line, "tipo de línea desconocido \"" + kind + "\"");
+    return false;
+  });
+  
+  if (ok && num_vertices == 0) {
+    error = "falta la línea \"p sp\"";
+    return false;
+  }
+  return ok;
+}
+
+bool ReadDimacsQueries(const char* begin, const char* end, std::vector<GraphQuery>& queries,
+                       std::string& error) {
+  queries.clear();
+  
+  return ForEachLine(begin, end, [&](int line, TextScanner& scanner) {
+    std::string kind = scanner.NextWord();
+    if (kind == "c" || kind == "p") {
+      return true;
+    }
+    
+    GraphQuery query = {0, 0};
+    bool valid = false;
+    if (kind == "s") {
+      valid = scanner.NextInt(query.start) && query.start >= 1;
+    } else if (kind == "q") {
+      valid = scanner.NextInt(query.start) && scanner.NextInt(query.goal) && query.start >= 1 && query.goal >= 1;
+    }
+    
+    if (!valid) {
+      error = LineError(line, "se esperaba \"s origen\" o \"q origen destino\"");
+      return false;
+    }
+    queries.push_back(query);
+    return true;
+  });
+}
+
+// Deja cada arista con from < to, sin lazos, ordenadas por (from, to) y sin
+// repetidas; de las aristas repetidas (o de los dos arcos de una arista de
+// DIMACS) se conserva la de menor coste
+void NormalizeEdges(std::vector<GraphEdge>& edges) {
+  std::size_t kept = 0;
+  for (std::size_t k = 0; k < edges.size(); ++k) {
+    GraphEdge edge = edges[k];
+    if (edge.from == edge.to) {
+      continue;
+    }
+    if (edge.from > edge.to) {
+      std::swap(edge.from, edge.to);
+    }
+    edges[kept++] = edge;
+  }
+  edges.resize(kept);
+  
+  std::sort(edges.begin(), edges.end(), [](const GraphEdge& a, const GraphEdge& b) {
+    if (a.from != b.from) {
+      return a.from < b.from;
+    }
+    if (a.to != b.to) {
+      return a.to < b.to;
+    }
+    return a.cost < b.cost;
+  });
+  
+  edges.erase(std::unique(edges.begin(), edges.end(), [](const GraphEdge& a, const GraphEdge& b) {
+    return a.from == b.from && a.to == b.to;
+  }), edges.end());
+}
+
+// Triángulo superior de distancias: V y después un valor por línea para
+// cada par (i, j) con i < j, -1 si no hay arista. Ocupa O(V^2)
+bool WriteTriangle(const std::string& filename, int num_vertices, const std::vector<GraphEdge>& edges, int decimals) {
+  TextWriter writer(filename);
+  if (!writer.IsOpen()) {
+    return false;
+  }
+  
+  writer.AppendInt(num_vertices);
+  writer.Append("\n");
+  std::size_t next = 0;
+  for (int i = 0; i < num_vertices; ++i) {
+    for (int j = i + 1; j < num_vertices; ++j) {
+      if (next < edges.size() && edges[next].from == i && edges[next].to == j) {
+        writer.AppendNumber(edges[next++].cost, decimals);
+        writer.Append("\n");
+      } else {
+        writer.Append("-1\n");
+      }
+    }
+  }
+  return writer.Close();
+}
+
+bool WriteEdgeList(const std::string& filename, const std::vector<GraphEdge>& edges, int decimals) {
+  TextWriter writer(filename);
+  if (!writer.IsOpen()) {
+    return false;
+  }
+  
+  for (const GraphEdge& edge : edges) {
+    writer.AppendInt(edge.from + 1);
+    writer.Append(" ");
+    writer.AppendInt(edge.to + 1);
+    writer.Append(" ");
+    writer.AppendNumber(edge.cost, decimals);
+    writer.Append("\n");
+  }
+  return writer.Close();
+}
+
+// Cada arista se escribe como dos arcos, como en los grafos de carreteras de DIMACS
+bool WriteDimacsGraph(const std::string& filename, int num_vertices, const std::vector<GraphEdge>& edges,
+                      int decimals) {
+  TextWriter writer(filename);
+  if (!writer.IsOpen()) {
+    return false;
+  }
+  
+  writer.Append("p sp ");
+  writer.AppendInt(num_vertices);
+  writer.Append(" ");
+  writer.AppendInt(2 * static_cast<long long>(edges.size()));
+  writer.Append("\n");
+  for (const GraphEdge& edge : edges) {
+    for (int direction = 0; direction < 2; ++direction) {
+      writer.Append("a ");
+      writer.AppendInt((direction == 0 ? edge.from : edge.to) + 1);
+      writer.Append(" ");
+      writer.AppendInt((direction == 0 ? edge.to : edge.from) + 1);
+      writer.Append(" ");
+      writer.AppendNumber(edge.cost, decimals);
+      writer.Append("\n");
+    }
+  }
+  return writer.Close();
+}
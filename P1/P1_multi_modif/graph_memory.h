@@ -0,0 +1,115 @@
+#ifndef GRAPH_MEMORY_H
+#define GRAPH_MEMORY_H
+
+#include <string>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Ubicación en memoria de los arrays grandes del grafo
+ *
+ * Por defecto los arrays son std::vector: páginas de 4 KiB que quedan en el
+ * nodo NUMA del hilo que las escribe primero, normalmente el de carga. Con
+ * las otras políticas cada array de al menos kHugePageBytes se mueve a una
+ * región contigua alineada a 2 MiB con páginas grandes transparentes
+ * (madvise MADV_HUGEPAGE), lo que reduce los fallos de TLB al recorrerlo, y
+ * opcionalmente se reparte entre los nodos: por turnos (interleave) o por
+ * bloques contiguos escritos cada uno desde un hilo fijado a una CPU
+ * (first-touch), de modo que los hilos que recorren el grafo por bloques
+ * encuentran su parte en su propio nodo.
+ */
+
+enum class GraphMemory {
+  kDefault,     // std::vector con páginas normales
+  kHugePages,   // Región contigua con páginas grandes
+  kInterleave,  // Páginas grandes repartidas por turnos entre todos los nodos (mbind)
+  kFirstTouch   // Páginas grandes escritas por bloques desde un hilo fijado por CPU
+};
+
+// Tamaño de una página grande; los arrays más pequeños no se mueven
+const std::size_t kHugePageBytes = std::size_t(2) << 20;
+
+/**
+ * @brief Región de memoria anónima reservada con mmap según una GraphMemory
+ *
+ * Solo se puede mover, no copiar; la región se libera al destruir el objeto.
+ */
+class GraphMemoryRegion {
+  public:
+    GraphMemoryRegion();
+    ~GraphMemoryRegion();
+    GraphMemoryRegion(GraphMemoryRegion&& other);
+    GraphMemoryRegion& operator=(GraphMemoryRegion&& other);
+    bool Allocate(std::size_t bytes, GraphMemory policy);
+    void Release();
+    void* Data() const;
+
+  private:
+    GraphMemoryRegion(const GraphMemoryRegion&) = delete;
+    GraphMemoryRegion& operator=(const GraphMemoryRegion&) = delete;
+
+    void* data_;              // Inicio de la región, alineado a kHugePageBytes (nullptr si no hay)
+    std::size_t bytes_;       // Bytes proyectados (múltiplo de kHugePageBytes)
+};
+
+/**
+ * @brief Copias pendientes a regiones recién reservadas, que se hacen todas juntas
+ *
+ * Cada array que se mueve a su región anota aquí su copia y Run las hace
+ * todas. Con kFirstTouch se lanza un único grupo de hilos de RunPinned para
+ * toda la carga y el hilo k copia el bloque k de cada región, en lugar de
+ * crear y esperar un grupo de hilos por array. Las copias se hacen en Run,
+ * así que los datos de origen deben seguir vivos hasta entonces: Keep
+ * conserva los que ya no pertenecen a nadie y los libera al terminar.
+ */
+class GraphMemoryFill {
+  public:
+    explicit GraphMemoryFill(GraphMemory policy);
+    GraphMemory GetPolicy() const;
+    void Add(void* target, const void* source, std::size_t bytes);
+    template <typename T>
+    void Keep(std::vector<T>& data);
+    void Run();
+
+  private:
+    struct Copy {
+      char* target;
+      const char* source;
+      std::size_t bytes;
+    };
+
+    GraphMemory policy_;
+    std::vector<Copy> copies_;
+    std::vector<std::shared_ptr<void>> kept_;   // Orígenes que se liberan tras copiarlos
+};
+
+// Se queda con el contenido de data (que queda vacío) hasta que termine Run
+template <typename T>
+void GraphMemoryFill::Keep(std::vector<T>& data) {
+  std::shared_ptr<std::vector<T>> kept = std::make_shared<std::vector<T>>();
+  kept->swap(data);
+  kept_.push_back(kept);
+}
+
+int NumaNodeCount();
+int NumMemoryWorkers();
+void RunPinned(int count, void (*task)(int, void*), void* context);
+std::string GraphMemoryName(GraphMemory memory);
+bool ParseGraphMemory(const std::string& name, GraphMemory& memory);
+
+/**
+ * @brief Ejecuta task(k) para k = 0 ... count - 1, cada una en un hilo fijado a la CPU k
+ *
+ * Es el reparto que usa kFirstTouch: el bloque k de cada array lo escribe el
+ * hilo de la CPU k, así que un recorrido lanzado también con RunPinned
+ * encuentra su bloque en su propio nodo.
+ */
+template <typename Task>
+void RunPinnedTasks(int count, Task& task) {
+  RunPinned(count, [](int k, void* context) {
+    (*static_cast<Task*>(context))(k);
+  }, &task);
+}
+
+#endif
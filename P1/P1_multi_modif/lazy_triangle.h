@@ -0,0 +1,83 @@
+#ifndef LAZY_TRIANGLE_H
+#define LAZY_TRIANGLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Valores del triángulo entre dos posiciones consecutivas del índice disperso
+const std::size_t kLazyIndexStride = 128;
+
+// Vecinos que se conservan decodificados, en total, en la caché de filas
+const std::size_t kDefaultLazyCacheEntries = std::size_t(1) << 22;
+
+// Vecino (0-based) y coste de una fila decodificada
+struct LazyEntry {
+  int neighbor;
+  double cost;
+};
+
+typedef std::vector<LazyEntry> LazyRow;
+
+/**
+ * @brief Acceso bajo demanda al triángulo de distancias de un fichero de texto
+ *
+ * Build recorre una vez el texto proyectado, comprueba que cada valor se
+ * puede leer y anota la posición del primer valor de cada fila del
+ * triángulo y, dentro de la fila, la de uno de cada kLazyIndexStride
+ * valores (8 bytes por cada kLazyIndexStride valores del fichero). Con ese índice el valor de un par
+ * (i, j) se lee saltando a la posición anotada más cercana y avanzando como
+ * mucho kLazyIndexStride - 1 tokens.
+ *
+ * Los vecinos de un vértice están en la columna de las filas anteriores y en
+ * su propia fila, así que Row los decodifica la primera vez que se piden y
+ * los guarda en una caché LRU limitada a un número total de vecinos. La
+ * memoria crece así con la parte del grafo que recorre la búsqueda y no con
+ * el tamaño del fichero, que debe seguir proyectado mientras se use.
+ *
+ * La caché se modifica desde los métodos const: no se puede usar desde
+ * varios hilos a la vez.
+ */
+class LazyTriangle {
+  public:
+    LazyTriangle();
+    bool Build(const char* begin, const char* end, int num_vertices, std::string& error);
+    void Clear();
+    void SetCacheCapacity(std::size_t entries);
+    long long NumEdges() const;
+    double ReadCost(int from_index, int to_index) const;
+    std::shared_ptr<const LazyRow> Row(int vertex_index) const;
+    std::size_t DecodedRows() const;
+    std::size_t CachedRows() const;
+    std::size_t IndexBytes() const;
+
+  private:
+    // Fila en la caché y su posición en la lista de uso
+    struct CacheSlot {
+      std::shared_ptr<const LazyRow> row;
+      std::list<int>::iterator position;
+    };
+
+    const char* Locate(int from_index, int to_index) const;
+    double ParseCost(const char* token) const;
+    std::shared_ptr<const LazyRow> DecodeRow(int vertex_index) const;
+    void Evict() const;
+
+    const char* begin_;                  // Texto proyectado (lo mantiene abierto el grafo)
+    const char* end_;
+    int num_vertices_;
+    long long num_edges_;                // Valores no negativos del triángulo
+    std::vector<uint64_t> checkpoints_;  // Posición en el texto de uno de cada kLazyIndexStride valores de cada fila
+    std::vector<uint64_t> first_checkpoint_;   // Primera posición de cada fila en checkpoints_
+    std::size_t capacity_;               // Vecinos (más uno por fila) que puede guardar la caché
+    mutable std::list<int> lru_;         // Filas en caché, la usada más recientemente al principio
+    mutable std::unordered_map<int, CacheSlot> cache_;
+    mutable std::size_t cached_entries_;
+    mutable std::size_t decoded_rows_;   // Filas decodificadas desde Build (incluye las expulsadas)
+};
+
+#endif
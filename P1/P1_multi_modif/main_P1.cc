@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <vector>
 #include "graph.h"
 #include "bfs.h"
 #include "dfs.h"
@@ -9,17 +10,70 @@
  * @brief Función para mostrar el uso del programa
  */
 void ShowUsage(const std::string& program_name) {
-  std::cout << "Uso: " << program_name << " <archivo_grafo> <vertice_origen> <vertice_destino> [algoritmo]" << std::endl;
-  std::cout << "  archivo_grafo: Archivo con el formato específico del grafo" << std::endl;
+  std::cout << "Uso: " << program_name << " [opciones] <archivo_grafo> <vertice_origen> <vertice_destino> [algoritmo]" << std::endl;
+  std::cout << "  archivo_grafo: Archivo con el formato específico del grafo, una lista de aristas" << std::endl;
+  std::cout << "                 (.el, .edges), un grafo DIMACS (.gr) o la versión binaria" << std::endl;
+  std::cout << "                 generada con convertir_grafo" << std::endl;
   std::cout << "  vertice_origen: Vértice de inicio (1-index)" << std::endl;
   std::cout << "  vertice_destino: Vértice objetivo (1-index)" << std::endl;
   std::cout << "  algoritmo: 'bfs' para búsqueda en amplitud, 'dfs' para búsqueda en profundidad" << std::endl;
   std::cout << "            Si no se especifica, se ejecutan ambos algoritmos" << std::endl;
   std::cout << std::endl;
+  std::cout << "Opciones:" << std::endl;
+  std::cout << "  --storage=auto|csr|packed|bitset|compressed|lazy: representación del grafo en memoria (auto" << std::endl;
+  std::cout << "                        por defecto: según la densidad y los costes; solo elige packed" << std::endl;
+  std::cout << "                        o bitset si todos los costes son exactos en float, lo que no" << std::endl;
+  std::cout << "                        ocurre con costes decimales como 2.236, así que los ficheros" << std::endl;
+  std::cout << "                        del problema quedan en csr; csr guarda solo las aristas;" << std::endl;
+  std::cout << "                        packed guarda el triángulo superior denso en float;" << std::endl;
+  std::cout << "                        bitset añade un mapa de bits de adyacencia por vértice;" << std::endl;
+  std::cout << "                        compressed codifica las filas csr en varint, varias veces" << std::endl;
+  std::cout << "                        más pequeñas, a cambio de decodificarlas al recorrerlas; lazy" << std::endl;
+  std::cout << "                        deja el triángulo de texto en el fichero y lee cada fila la" << std::endl;
+  std::cout << "                        primera vez que se recorre, para unas pocas consultas sobre" << std::endl;
+  std::cout << "                        ficheros que no caben en memoria)" << std::endl;
+  std::cout << "  --lazy-cache=N: vecinos decodificados que conserva lazy entre recorridos (" << kDefaultLazyCacheEntries << " por" << std::endl;
+  std::cout << "                        defecto); las filas menos usadas se descartan" << std::endl;
+  std::cout << "  --format=auto|triangle|edges|dimacs: formato del archivo de texto (auto por defecto:" << std::endl;
+  std::cout << "                        según la extensión)" << std::endl;
+  std::cout << "  --reorder=none|rcm|degree: renumeración interna de los vértices para mejorar la" << std::endl;
+  std::cout << "                        localidad en csr (los resultados usan los números del archivo)" << std::endl;
+  std::cout << "  --no-snapshot: no usar ni crear la instantánea binaria <archivo_grafo>.<repr>.snapshot" << std::endl;
+  std::cout << "                 con la que se evita volver a parsear el fichero de texto" << std::endl;
+  std::cout << "  --quantize-weights: guardar los costes csr como enteros de 16 o 32 bits si tienen pocos" << std::endl;
+  std::cout << "                 decimales (se comprueba que no se pierde precisión; si no, double)" << std::endl;
+  std::cout << "  --memory=default|hugepages|interleave|first-touch: ubicación de los arrays del grafo" << std::endl;
+  std::cout << "                 (páginas grandes y, con interleave o first-touch, reparto entre nodos NUMA)" << std::endl;
+  std::cout << "  --trace=none|counters|full: qué se registra del recorrido (full por defecto: los nodos" << std::endl;
+  std::cout << "                 generados e inspeccionados en cada iteración; counters solo cuántos)" << std::endl;
+  std::cout << "  --shared=nombre: usar el grafo publicado en el segmento de memoria compartida nombre" << std::endl;
+  std::cout << "                 o, si no existe, cargarlo y publicarlo ahí para los siguientes procesos" << std::endl;
+  std::cout << "  --stats: mostrar la representación elegida, la densidad y los grados del grafo" << std::endl;
+  std::cout << std::endl;
   std::cout << "Ejemplos:" << std::endl;
   std::cout << "  " << program_name << " grafo.txt 1 4" << std::endl;
   std::cout << "  " << program_name << " grafo.txt 1 4 bfs" << std::endl;
   std::cout << "  " << program_name << " grafo.txt 1 4 dfs" << std::endl;
+  std::cout << "  " << program_name << " --storage=packed grafo.txt 1 4" << std::endl;
+  std::cout << "  " << program_name << " USA-road-d.NY.gr 1 1000 bfs" << std::endl;
+  std::cout << "  " << program_name << " --shared=ny USA-road-d.NY.gr 1 1000 bfs" << std::endl;
+}
+
+/**
+ * @brief Interpreta una opción: --trace=, --stats o una de las opciones de
+ *        carga del grafo (ParseGraphLoadOption)
+ * @return false si la opción no es reconocida
+ */
+bool ParseOption(const std::string& option, GraphLoadOptions& options, TraceLevel& trace, bool& stats) {
+  const std::string kTrace = "--trace=";
+  if (option.compare(0, kTrace.size(), kTrace) == 0) {
+    return ParseTraceLevel(option.substr(kTrace.size()), trace);
+  }
+  if (option == "--stats") {
+    stats = true;
+    return true;
+  }
+  return ParseGraphLoadOption(option, options);
 }
 
 void ExecuteSearch(SearchAlgorithm* algorithm, int start, int goal) {
@@ -44,28 +98,46 @@ void ExecuteSearch(SearchAlgorithm* algorithm, int start, int goal) {
 int main(int argc, char* argv[]) {
   std::cout << "\n=== BÚSQUEDAS NO INFORMADAS ===" << std::endl;
   
-  if (argc < 4 || argc > 5) {
+  // Separar las opciones (--nombre=valor) de los argumentos posicionales
+  std::vector<std::string> args;
+  GraphLoadOptions options;
+  TraceLevel trace = TraceLevel::kFull;
+  bool stats = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.compare(0, 2, "--") == 0) {
+      if (!ParseOption(arg, options, trace, stats)) {
+        std::cerr << "Error: Opción no reconocida: " << arg << std::endl;
+        ShowUsage(argv[0]);
+        return 1;
+      }
+    } else {
+      args.push_back(arg);
+    }
+  }
+  
+  if (args.size() < 3 || args.size() > 4) {
     ShowUsage(argv[0]);
     return 1;
   }
   
-  std::string graph_file = argv[1];
+  std::string graph_file = args[0];
   int start_vertex, goal_vertex;
   
   try {
-    start_vertex = std::stoi(argv[2]);
-    goal_vertex = std::stoi(argv[3]);
+    start_vertex = std::stoi(args[1]);
+    goal_vertex = std::stoi(args[2]);
   } catch (const std::exception& e) {
     std::cerr << "Error: Los vértices deben ser números enteros válidos" << std::endl;
     return 1;
   }
   
   std::string algorithm_choice = "both";
-  if (argc == 5) {
-    algorithm_choice = argv[4];
+  if (args.size() == 4) {
+    algorithm_choice = args[3];
   }
   
-  Graph graph(graph_file);
+  Graph graph(graph_file, options);
   
   if (graph.GetNumVertices() == 0) {
     std::cerr << "Error: No se pudo cargar el grafo" << std::endl;
@@ -73,6 +145,25 @@ int main(int argc, char* argv[]) {
   }
   
   std::cout << "\nGrafo cargado: " << graph.GetNumVertices() << " vértices, " << graph.GetNumEdges() << " aristas" << std::endl;
+  if (stats && graph.GetStorage() == GraphStorage::kLazy) {
+    // Las estadísticas obligarían a decodificar todas las filas
+    std::cout << "Representación: lazy; índice de " << graph.GetLazyRows().IndexBytes() / 1024
+              << " KiB sobre el fichero proyectado" << std::endl;
+  } else if (stats) {
+    const GraphStats& graph_stats = graph.GetStats();
+    std::cout << "Representación: " << GraphStorageName(graph.GetStorage())
+              << (graph.IsStorageAutomatic() ? " (elegida automáticamente)" : "") << "; densidad "
+              << graph_stats.density << ", grado medio " << graph_stats.average_degree << ", grado máximo "
+              << graph_stats.max_degree << std::endl;
+  }
+  if (options.quantize_weights) {
+    if (graph.GetWeightBytes() < 8) {
+      std::cout << "Costes cuantizados en " << 8 * graph.GetWeightBytes() << " bits con "
+                << graph.GetWeightDecimals() << " decimales" << std::endl;
+    } else {
+      std::cout << "Costes en double: no se pueden cuantizar sin perder precisión" << std::endl;
+    }
+  }
   
   if (!graph.IsValidVertex(start_vertex) || !graph.IsValidVertex(goal_vertex)) {
     std::cerr << "Error: Vértices inválidos. Deben estar entre 1 y " << graph.GetNumVertices() << std::endl;
@@ -82,15 +173,21 @@ int main(int argc, char* argv[]) {
   std::cout << "Buscar camino de " << start_vertex << " a " << goal_vertex << std::endl;
   
   if (algorithm_choice == "bfs" || algorithm_choice == "both") {
-    BFS bfs_algorithm(&graph);
+    BFS bfs_algorithm(&graph, trace);
     ExecuteSearch(&bfs_algorithm, start_vertex, goal_vertex);
   }
   
   if (algorithm_choice == "dfs" || algorithm_choice == "both") {
-    DFS dfs_algorithm(&graph);
+    DFS dfs_algorithm(&graph, trace);
     ExecuteSearch(&dfs_algorithm, start_vertex, goal_vertex);
   }
   
+  if (graph.GetStorage() == GraphStorage::kLazy) {
+    const LazyTriangle& rows = graph.GetLazyRows();
+    std::cout << "Filas decodificadas bajo demanda: " << rows.DecodedRows() << " de " << graph.GetNumVertices()
+              << " (" << rows.CachedRows() << " en caché)" << std::endl;
+  }
+  
   if (algorithm_choice != "bfs" && algorithm_choice != "dfs" && algorithm_choice != "both") {
     std::cerr << "Error: Algoritmo no reconocido. Use 'bfs', 'dfs' o déjelo vacío para ambos" << std::endl;
     return 1;
@@ -0,0 +1,194 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "binary_format.h"
+
+/**
+ * @brief Función para mostrar el uso del conversor
+ */
+void ShowUsage(const std::string& program_name) {
+  std::cout << "Uso: " << program_name << " [--storage=auto|csr|packed|bitset|compressed] [--format=auto|triangle|edges|dimacs]" << std::endl;
+  std::cout << "       [--reorder=none|rcm|degree] [--quantize-weights] <grafo_texto> <grafo_binario>" << std::endl;
+  std::cout << "     " << program_name << " --verify <grafo_binario>" << std::endl;
+  std::cout << "     " << program_name << " [--storage=...] [--format=...] [--reorder=...] --publish=<nombre> <grafo>" << std::endl;
+  std::cout << "     " << program_name << " --unpublish=<nombre>" << std::endl;
+  std::cout << "     " << program_name << " --dump [--rows=a-b] [--columns=a-b] [--edges-only] <grafo>" << std::endl;
+  std::cout << "     " << program_name << " --stats <grafo>" << std::endl;
+  std::cout << "  Convierte un grafo de texto (triángulo superior de distancias, lista de aristas o DIMACS)" << std::endl;
+  std::cout << "  al formato binario que busquedas_no_informadas abre con mmap sin parsear." << std::endl;
+  std::cout << "  --storage: representación que se guarda (auto por defecto: según la densidad, y csr si algún coste no es exacto en float)" << std::endl;
+  std::cout << "  --format: formato del grafo de texto (auto por defecto: según la extensión)" << std::endl;
+  std::cout << "  --reorder: renumeración de los vértices que se guarda con el grafo (none por defecto)" << std::endl;
+  std::cout << "  --quantize-weights: guarda los costes csr como enteros de 16/32 bits si no se pierde precisión" << std::endl;
+  std::cout << "  Se aceptan también las demás opciones de carga de busquedas_no_informadas (--memory," << std::endl;
+  std::cout << "  --shared, --no-snapshot...); las instantáneas están desactivadas por defecto" << std::endl;
+  std::cout << "  --verify: comprueba la cabecera y la suma de comprobación de un fichero binario" << std::endl;
+  std::cout << "  --publish: publica el grafo en el segmento de memoria compartida <nombre>, al que se" << std::endl;
+  std::cout << "             adjuntan los procesos lanzados con --shared=<nombre>" << std::endl;
+  std::cout << "  --unpublish: elimina el segmento de memoria compartida <nombre>" << std::endl;
+  std::cout << "  --stats: muestra la representación elegida, la densidad y el histograma de grados" << std::endl;
+  std::cout << "  --dump: escribe la matriz de adyacencia por la salida estándar, fila a fila; --rows y" << std::endl;
+  std::cout << "          --columns la limitan a una ventana y --edges-only lista solo las aristas" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Ejemplo:" << std::endl;
+  std::cout << "  " << program_name << " ID-1.txt ID-1.bin" << std::endl;
+}
+
+/**
+ * @brief Muestra la representación del grafo y las estadísticas con que se eligió
+ */
+void PrintStats(const Graph& graph) {
+  const GraphStats& stats = graph.GetStats();
+  std::cout << "Vértices: " << graph.GetNumVertices() << ", aristas: " << graph.GetNumEdges() << std::endl;
+  std::cout << "Representación: " << GraphStorageName(graph.GetStorage())
+            << (graph.IsStorageAutomatic() ? " (elegida automáticamente)" : "") << std::endl;
+  std::cout << "Densidad: " << stats.density << std::endl;
+  std::cout << "Grado: medio " << stats.average_degree << ", mínimo " << stats.min_degree
+            << ", máximo " << stats.max_degree << std::endl;
+  std::cout << "Costes exactos en float: " << (stats.float_exact ? "sí" : "no") << std::endl;
+  std::cout << "Histograma de grados:" << std::endl;
+  for (std::size_t b = 0; b < stats.degree_histogram.size(); ++b) {
+    if (b == 0) {
+      std::cout << "  0: ";
+    } else {
+      std::cout << "  [" << (1LL << (b - 1)) << ", " << (1LL << b) << "): ";
+    }
+    std::cout << stats.degree_histogram[b] << std::endl;
+  }
+}
+
+/**
+ * @brief Interpreta un rango de vértices "a-b" (o "a" para un solo vértice)
+ */
+bool ParseRange(const std::string& text, int& first, int& last) {
+  try {
+    std::size_t dash = text.find('-');
+    first = std::stoi(text.substr(0, dash));
+    last = dash == std::string::npos ? first : std::stoi(text.substr(dash + 1));
+  } catch (const std::exception&) {
+    return false;
+  }
+  return first >= 1 && last >= first;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> args;
+  GraphLoadOptions options;
+  options.use_snapshot = false;
+  bool verify = false;
+  bool dump = false;
+  bool stats = false;
+  MatrixWindow window;
+  const std::string kRows = "--rows=";
+  const std::string kColumns = "--columns=";
+  std::string publish_name;
+  std::string unpublish_name;
+  const std::string kPublish = "--publish=";
+  const std::string kUnpublish = "--unpublish=";
+  
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    // Las opciones de carga (--storage, --format, --reorder, ...) son las de los demás programas
+    if (ParseGraphLoadOption(arg, options)) {
+      continue;
+    }
+    
+    if (arg == "--verify") {
+      verify = true;
+    } else if (arg == "--dump") {
+      dump = true;
+    } else if (arg == "--stats") {
+      stats = true;
+    } else if (arg == "--edges-only") {
+      window.edges_only = true;
+    } else if (arg.compare(0, kRows.size(), kRows) == 0) {
+      if (!ParseRange(arg.substr(kRows.size()), window.first_row, window.last_row)) {
+        std::cerr << "Error: Rango de filas no válido: " << arg << std::endl;
+        return 1;
+      }
+    } else if (arg.compare(0, kColumns.size(), kColumns) == 0) {
+      if (!ParseRange(arg.substr(kColumns.size()), window.first_column, window.last_column)) {
+        std::cerr << "Error: Rango de columnas no válido: " << arg << std::endl;
+        return 1;
+      }
+    } else if (arg.compare(0, kPublish.size(), kPublish) == 0) {
+      publish_name = arg.substr(kPublish.size());
+    } else if (arg.compare(0, kUnpublish.size(), kUnpublish) == 0) {
+      unpublish_name = arg.substr(kUnpublish.size());
+    } else if (arg.compare(0, 2, "--") == 0) {
+      std::cerr << "Error: Opción no reconocida: " << arg << std::endl;
+      ShowUsage(argv[0]);
+      return 1;
+    } else {
+      args.push_back(arg);
+    }
+  }
+  
+  if (verify) {
+    if (args.size() != 1) {
+      ShowUsage(argv[0]);
+      return 1;
+    }
+    
+    std::string error;
+    if (!VerifyBinaryGraphFile(args[0], error)) {
+      std::cerr << "Error: " << args[0] << ": " << error << std::endl;
+      return 1;
+    }
+    std::cout << args[0] << ": correcto" << std::endl;
+    return 0;
+  }
+  
+  if (!unpublish_name.empty()) {
+    if (!args.empty()) {
+      ShowUsage(argv[0]);
+      return 1;
+    }
+    if (!Graph::RemoveShared(unpublish_name)) {
+      std::cerr << "Error: No existe el segmento compartido " << unpublish_name << std::endl;
+      return 1;
+    }
+    std::cout << "Segmento " << unpublish_name << " eliminado" << std::endl;
+    return 0;
+  }
+  
+  if (args.size() != (publish_name.empty() && !dump && !stats ? 2u : 1u)) {
+    ShowUsage(argv[0]);
+    return 1;
+  }
+  
+  Graph graph(args[0], options);
+  if (graph.GetNumVertices() == 0) {
+    std::cerr << "Error: No se pudo cargar el grafo" << std::endl;
+    return 1;
+  }
+  
+  if (dump) {
+    graph.WriteMatrix(std::cout, window);
+    return 0;
+  }
+  if (stats) {
+    PrintStats(graph);
+    return 0;
+  }
+  
+  if (!publish_name.empty()) {
+    if (!graph.PublishShared(publish_name)) {
+      std::cerr << "Error: No se pudo crear el segmento compartido " << publish_name
+                << " (puede que ya exista)" << std::endl;
+      return 1;
+    }
+    std::cout << "Grafo de " << graph.GetNumVertices() << " vértices y " << graph.GetNumEdges()
+              << " aristas publicado en " << publish_name << " (" << GraphStorageName(graph.GetStorage()) << ")" << std::endl;
+    return 0;
+  }
+  
+  if (!graph.SaveBinary(args[1])) {
+    return 1;
+  }
+  
+  std::cout << "Grafo de " << graph.GetNumVertices() << " vértices y " << graph.GetNumEdges()
+            << " aristas guardado en " << args[1] << " (" << GraphStorageName(graph.GetStorage()) << ")" << std::endl;
+  return 0;
+}
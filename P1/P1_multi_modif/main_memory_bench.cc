@@ -0,0 +1,151 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "graph.h"
+#include "graph_memory.h"
+
+/**
+ * @brief Función para mostrar el uso del banco de pruebas de memoria
+ */
+void ShowUsage(const std::string& program_name) {
+  std::cout << "Uso: " << program_name << " [opciones] <archivo_grafo>" << std::endl;
+  std::cout << "  Carga el grafo con cada política de memoria y mide el rendimiento de un recorrido" << std::endl;
+  std::cout << "  paralelo de todas las aristas: cada hilo, fijado a una CPU, recorre con" << std::endl;
+  std::cout << "  ForEachNeighbor un bloque contiguo de vértices (el mismo reparto que first-touch)." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Opciones:" << std::endl;
+  std::cout << "  --memory=default|hugepages|interleave|first-touch|all: políticas que se miden (all" << std::endl;
+  std::cout << "                        por defecto)" << std::endl;
+  std::cout << "  --threads=N: hilos del recorrido (uno por CPU por defecto)" << std::endl;
+  std::cout << "  --rounds=R: recorridos completos que se miden por política (5 por defecto)" << std::endl;
+  std::cout << "  --storage=auto|csr|packed|bitset|compressed: representación del grafo (auto por defecto)" << std::endl;
+  std::cout << "  Se aceptan también las demás opciones de carga de busquedas_no_informadas (--format," << std::endl;
+  std::cout << "  --reorder, --quantize-weights, --no-snapshot, --shared)" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Ejemplo:" << std::endl;
+  std::cout << "  " << program_name << " --threads=16 sintetico_grid_1m.bin" << std::endl;
+}
+
+// Recorrido de los vértices [first, last) de un hilo
+struct SweepTask {
+  const Graph* graph;
+  int threads;
+  int rounds;
+  std::vector<double> sums;
+  std::vector<long long> visited;
+  
+  void operator()(int k) {
+    int vertices = graph->GetNumVertices();
+    int first = static_cast<int>(static_cast<long long>(vertices) * k / threads) + 1;
+    int last = static_cast<int>(static_cast<long long>(vertices) * (k + 1) / threads) + 1;
+    double sum = 0.0;
+    long long count = 0;
+    for (int round = 0; round < rounds; ++round) {
+      for (int v = first; v < last; ++v) {
+        graph->ForEachNeighbor(v, [&sum, &count](int, double cost) {
+          sum += cost;
+          count++;
+        });
+      }
+    }
+    sums[k] = sum;
+    visited[k] = count;
+  }
+};
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> args;
+  GraphLoadOptions options;
+  std::vector<GraphMemory> policies;
+  int threads = NumMemoryWorkers();
+  int rounds = 5;
+  
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      std::size_t equals = arg.find('=');
+      std::string name = arg.substr(0, equals);
+      std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+      bool valid = true;
+  
+      if (arg.compare(0, 2, "--") != 0) {
+        args.push_back(arg);
+      } else if (arg == "--memory=all") {
+        policies.clear();
+      } else if (ParseGraphLoadOption(arg, options)) {
+        // Cada --memory añade una política a las que se miden
+        if (name == "--memory") {
+          policies.push_back(options.memory);
+        }
+      } else if (name == "--threads") {
+        threads = std::stoi(value);
+        valid = threads > 0;
+      } else if (name == "--rounds") {
+        rounds = std::stoi(value);
+        valid = rounds > 0;
+      } else {
+        valid = false;
+      }
+  
+      if (!valid) {
+        std::cerr << "Error: Opción no válida: " << arg << std::endl;
+        return 1;
+      }
+    }
+  } catch (const std::exception&) {
+    std::cerr << "Error: Valor numérico no válido" << std::endl;
+    return 1;
+  }
+  
+  // La caché de filas de lazy no admite varios hilos a la vez (ver LazyTriangle)
+  if (options.storage == GraphStorage::kLazy) {
+    std::cerr << "Error: La representación lazy no se puede recorrer desde varios hilos" << std::endl;
+    return 1;
+  }
+  if (args.size() != 1) {
+    ShowUsage(argv[0]);
+    return 1;
+  }
+  if (policies.empty()) {
+    policies = {GraphMemory::kDefault, GraphMemory::kHugePages, GraphMemory::kInterleave, GraphMemory::kFirstTouch};
+  }
+  
+  std::cout << "Nodos NUMA: " << NumaNodeCount() << ", hilos: " << threads << ", recorridos: " << rounds << std::endl;
+  std::cout << std::setw(12) << "memoria" << "  " << std::setw(12) << "carga (ms)" << "  " << std::setw(14)
+            << "recorrido (ms)" << "  " << std::setw(14) << "Mvecinos/s" << std::endl;
+  
+  for (GraphMemory memory : policies) {
+    options.memory = memory;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Graph graph(args[0], options);
+    std::chrono::steady_clock::time_point loaded = std::chrono::steady_clock::now();
+    if (graph.GetNumVertices() == 0) {
+      std::cerr << "Error: No se pudo cargar el grafo" << std::endl;
+      return 1;
+    }
+  
+    // Un recorrido sin medir para que todas las políticas partan con las páginas presentes
+    SweepTask task = {&graph, threads, 1, std::vector<double>(threads), std::vector<long long>(threads)};
+    RunPinnedTasks(threads, task);
+  
+    task.rounds = rounds;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RunPinnedTasks(threads, task);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  
+    long long entries = 0;
+    for (long long count : task.visited) {
+      entries += count;
+    }
+    double load_ms = std::chrono::duration<double, std::milli>(loaded - begin).count();
+    double sweep_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << std::setw(12) << GraphMemoryName(memory) << "  " << std::fixed << std::setprecision(1)
+              << std::setw(12) << load_ms << "  " << std::setw(14) << sweep_ms << "  " << std::setw(14)
+              << entries / (sweep_ms * 1000.0) << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+  }
+  
+  return 0;
+}
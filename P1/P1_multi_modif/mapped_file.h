@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Fichero proyectado en memoria (mmap) de solo lectura
+ *
+ * Permite recorrer el contenido del fichero directamente desde la caché de
+ * páginas del sistema, sin copiarlo a un buffer intermedio. También puede
+ * proyectar un segmento de memoria compartida POSIX (shm_open), de modo que
+ * varios procesos lean las mismas páginas físicas. La proyección se libera al
+ * cerrar el fichero o al destruir el objeto.
+ */
+class MappedFile {
+  public:
+    MappedFile();
+    ~MappedFile();
+    bool Open(const std::string& filename);
+    bool OpenShared(const std::string& name);
+    void Close();
+    void AdviseSequential() const;
+    bool IsOpen() const;
+    const char* Data() const;
+    std::size_t Size() const;
+
+  private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    bool Map();
+
+    int fd_;             // Descriptor del fichero abierto (-1 si está cerrado)
+    void* data_;         // Inicio de la proyección (nullptr si el fichero está vacío)
+    std::size_t size_;   // Tamaño del fichero en bytes
+};
+
+#endif
@@ -1,22 +1,76 @@
 #ifndef NODE_H
 #define NODE_H
 
-#include <memory>
+#include <vector>
 
 /**
  * @brief Clase para representar un nodo en el árbol de búsqueda
+ *
+ * El padre se guarda como posición en el NodeArena de la búsqueda, no como
+ * puntero: los nodos no se reservan uno a uno ni se liberan en cadena.
  */
 class Node {
   public:
-    Node(int vertex, std::shared_ptr<Node> parent = nullptr, double path_cost = 0.0);
+    // Padre de la raíz del árbol de búsqueda
+    static const int kNoParent = -1;
+    
+    Node(int vertex, int parent = kNoParent, double path_cost = 0.0);
     int GetVertex() const;
-    std::shared_ptr<Node> GetParent() const;
+    int GetParent() const;
     double GetPathCost() const;
 
   private:
-    int vertex_;                    // Vértice del nodo que representa
-    std::shared_ptr<Node> parent_;  // Puntero al nodo padre
-    double path_cost_;              // Costo acumulado desde el nodo inicial
+    int vertex_;        // Vértice del nodo que representa
+    int parent_;        // Posición del nodo padre en el arena (kNoParent en la raíz)
+    double path_cost_;  // Costo acumulado desde el nodo inicial
 };
 
-#endif
\ No newline at end of file
+/**
+ * @brief Nodos generados durante una búsqueda, en orden de generación
+ *
+ * Clear vacía el arena sin liberar su memoria, así que a partir de la
+ * primera búsqueda generar nodos no reserva memoria salvo que la búsqueda
+ * sea más grande que todas las anteriores. Al terminar se libera de una vez.
+ */
+class NodeArena {
+  public:
+    int Add(int vertex, int parent, double path_cost);
+    const Node& operator[](int index) const;
+    int Size() const;
+    void Clear();
+
+  private:
+    std::vector<Node> nodes_;
+};
+
+inline Node::Node(int vertex, int parent, double path_cost)
+  : vertex_(vertex), parent_(parent), path_cost_(path_cost) {
+}
+
+inline int Node::GetVertex() const {
+  return vertex_;
+}
+
+inline int Node::GetParent() const {
+  return parent_;
+}
+
+inline double Node::GetPathCost() const {
+  return path_cost_;
+}
+
+// Añade un nodo y devuelve su posición en el arena
+inline int NodeArena::Add(int vertex, int parent, double path_cost) {
+  nodes_.push_back(Node(vertex, parent, path_cost));
+  return static_cast<int>(nodes_.size()) - 1;
+}
+
+inline const Node& NodeArena::operator[](int index) const {
+  return nodes_[index];
+}
+
+inline int NodeArena::Size() const {
+  return static_cast<int>(nodes_.size());
+}
+
+#endif
@@ -4,27 +4,39 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <utility>
 
-SearchAlgorithm::SearchAlgorithm(const Graph* graph) : graph_(graph), current_iteration_(0) {
+SearchAlgorithm::SearchAlgorithm(const Graph* graph, TraceLevel trace)
+  : graph_(graph), trace_(trace), current_iteration_(0), generated_count_(0), inspected_count_(0) {
 }
 
 SearchAlgorithm::~SearchAlgorithm() {
 }
 
+// Los nodos se registran con su número del fichero aunque el grafo esté
+// reordenado. Solo se añaden al final del registro, sin ordenar: O(1)
+// amortizado. El informe ordena cada iteración una sola vez
 void SearchAlgorithm::MarkNodeGenerated(int vertex) {
-  generated_nodes_.push_back(vertex);
-  std::sort(generated_nodes_.begin(), generated_nodes_.end());
+  if (trace_ == TraceLevel::kNone) {
+    return;
+  }
+  generated_count_++;
+  if (trace_ != TraceLevel::kFull) {
+    return;
+  }
+  
+  iterations_.generated.push_back(graph_->ToExternal(vertex));
 }
 
-std::vector<int> SearchAlgorithm::ReconstructPath(std::shared_ptr<Node> goal_node) const {
+// Camino desde el origen hasta el nodo goal_node del arena: O(longitud)
+std::vector<int> SearchAlgorithm::ReconstructPath(int goal_node) const {
   std::vector<int> path;
-  std::shared_ptr<Node> current = goal_node;
   
-  // Construir el camino hacia atrás
-  while (current != nullptr) {
-    path.insert(path.begin(), current->GetVertex());
-    current = current->GetParent();
+  // Construir el camino hacia atrás y darle la vuelta
+  for (int current = goal_node; current != Node::kNoParent; current = nodes_[current].GetParent()) {
+    path.push_back(graph_->ToExternal(nodes_[current].GetVertex()));
   }
+  std::reverse(path.begin(), path.end());
   
   return path;
 }
@@ -36,35 +48,62 @@ double SearchAlgorithm::CalculatePathCost(const std::vector<int>& path) const {
   
   double total_cost = 0.0;
   for (size_t i = 0; i < path.size() - 1; ++i) {
-    double edge_cost = graph_->GetEdgeCost(path[i], path[i + 1]);
+    double edge_cost = graph_->GetEdgeCost(graph_->ToInternal(path[i]), graph_->ToInternal(path[i + 1]));
     total_cost += edge_cost;
   }
   
   return total_cost;
 }
 
-// Agrega información de la iteración actual
+// Cierra la iteración actual: anota hasta dónde llegan las dos listas
 void SearchAlgorithm::AddIteration() {
+  if (trace_ == TraceLevel::kNone) {
+    return;
+  }
   current_iteration_++;
-  IterationInfo info(current_iteration_);
+  if (trace_ != TraceLevel::kFull) {
+    return;
+  }
   
-  info.generated_nodes = generated_nodes_;
-  info.inspected_nodes = inspected_nodes_;
-  iterations_.push_back(info);
+  iterations_.generated_end.push_back(iterations_.generated.size());
+  iterations_.inspected_end.push_back(iterations_.inspected.size());
 }
 
+// Anota el nodo solo la primera vez que se inspecciona en la búsqueda. La
+// comprobación es un acceso a inspected_marks_, no una búsqueda en la lista
 void SearchAlgorithm::MarkNodeInspected(int vertex) {
-  if (std::find(inspected_nodes_.begin(), inspected_nodes_.end(), vertex) == inspected_nodes_.end()) {
-    inspected_nodes_.push_back(vertex);
+  if (trace_ == TraceLevel::kNone || inspected_marks_.Contains(vertex)) {
+    return;
+  }
+  inspected_marks_.Insert(vertex);
+  inspected_count_++;
+  if (trace_ != TraceLevel::kFull) {
+    return;
   }
+  
+  iterations_.inspected.push_back(graph_->ToExternal(vertex));
 }
 
 // Reinicia las estructuras para nueva búsqueda
 void SearchAlgorithm::Reset() {
-  generated_nodes_.clear();
-  inspected_nodes_.clear();
-  iterations_.clear();
+  iterations_.Clear();
   current_iteration_ = 0;
+  generated_count_ = 0;
+  inspected_count_ = 0;
+  nodes_.Clear();
+  explored_.Reset(graph_->GetNumVertices());
+  inspected_marks_.Reset(graph_->GetNumVertices());
+}
+
+// Pasa al resultado lo registrado durante la búsqueda. Las iteraciones se
+// mueven, no se copian: la siguiente búsqueda empieza con iterations_ vacío
+void SearchAlgorithm::FinishResult(SearchResult& result) {
+  result.trace = trace_;
+  result.num_iterations = current_iteration_;
+  result.generated_count = generated_count_;
+  result.inspected_count = inspected_count_;
+  result.iterations = std::move(iterations_);
+  iterations_.Clear();
 }
 
 std::string SearchAlgorithm::GenerateDetailedReport(const SearchResult& result, int start, int goal) const {
@@ -78,28 +117,45 @@ std::string SearchAlgorithm::GenerateDetailedReport(const SearchResult& result,
   oss << "Vértice destino: " << goal << "\n";
   oss << "--------------------------------------\n";
   
-  // Información de cada iteración
-  for (const auto& iteration : result.iterations) {
-    oss << "Iteración " << iteration.iteration_number << "\n";
+  if (result.trace == TraceLevel::kCounters) {
+    oss << "Iteraciones: " << result.num_iterations << "\n";
+    oss << "Nodos generados: " << result.generated_count << "\n";
+    oss << "Nodos inspeccionados: " << result.inspected_count << "\n";
+    oss << "--------------------------------------\n";
+  }
+  
+  // Información de cada iteración (solo con TraceLevel::kFull). Las listas
+  // acumuladas se reconstruyen recorriendo el registro: en cada iteración
+  // solo se ordenan sus nodos generados, que se mezclan con los anteriores
+  const IterationLog& log = result.iterations;
+  std::vector<int> generated;
+  generated.reserve(log.generated.size());
+  for (std::size_t k = 0; k < log.Size(); ++k) {
+    std::size_t previous = generated.size();
+    generated.insert(generated.end(), log.generated.begin() + previous, log.generated.begin() + log.generated_end[k]);
+    std::sort(generated.begin() + previous, generated.end());
+    std::inplace_merge(generated.begin(), generated.begin() + previous, generated.end());
+    
+    oss << "Iteración " << k + 1 << "\n";
     
     oss << "Nodos generados: ";
-    if (iteration.generated_nodes.empty()) {
+    if (generated.empty()) {
       oss << "-";
     } else {
-      for (size_t i = 0; i < iteration.generated_nodes.size(); ++i) {
+      for (size_t i = 0; i < generated.size(); ++i) {
         if (i > 0) oss << ", ";
-        oss << iteration.generated_nodes[i];
+        oss << generated[i];
       }
     }
     oss << "\n";
     
     oss << "Nodos inspeccionados: ";
-    if (iteration.inspected_nodes.empty()) {
+    if (log.inspected_end[k] == 0) {
       oss << "-";
     } else {
-      for (size_t i = 0; i < iteration.inspected_nodes.size(); ++i) {
+      for (size_t i = 0; i < log.inspected_end[k]; ++i) {
         if (i > 0) oss << ", ";
-        oss << iteration.inspected_nodes[i];
+        oss << log.inspected[i];
       }
     }
     oss << "\n";
@@ -117,6 +173,9 @@ std::string SearchAlgorithm::GenerateDetailedReport(const SearchResult& result,
     oss << "--------------------------------------\n";
     oss << "Costo: " << std::fixed << std::setprecision(2) << result.total_cost << "\n";
   } else {
+    if (result.unreachable) {
+      oss << "Los vértices están en componentes conexas distintas\n";
+    }
     oss << "No se encontró camino entre " << start << " y " << goal << "\n";
   }
   oss << "--------------------------------------\n";
@@ -136,4 +195,17 @@ bool SearchAlgorithm::SaveResultToFile(const SearchResult& result, int start, in
   file.close();
   
   return true;
-}
\ No newline at end of file
+}
+
+bool ParseTraceLevel(const std::string& name, TraceLevel& trace) {
+  if (name == "none") {
+    trace = TraceLevel::kNone;
+  } else if (name == "counters") {
+    trace = TraceLevel::kCounters;
+  } else if (name == "full") {
+    trace = TraceLevel::kFull;
+  } else {
+    return false;
+  }
+  return true;
+}
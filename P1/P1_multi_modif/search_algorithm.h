@@ -3,51 +3,93 @@
 
 #include "graph.h"
 #include "node.h"
+#include "visited_set.h"
 #include <vector>
 #include <string>
-#include <memory>
+#include <cstddef>
 
-// Estructura para almacenar información de cada iteración
-struct IterationInfo {
-  int iteration_number;
-  std::vector<int> generated_nodes;
-  std::vector<int> inspected_nodes;
+// Información que registra la búsqueda sobre su recorrido
+enum class TraceLevel {
+  kNone,      // Nada: solo el camino y su coste (consultas en producción)
+  kCounters,  // Número de iteraciones y de nodos generados e inspeccionados
+  kFull       // Además, los nodos generados e inspeccionados acumulados en cada iteración
+};
+
+bool ParseTraceLevel(const std::string& name, TraceLevel& trace);
+
+// Registro de las iteraciones de una búsqueda (TraceLevel::kFull). En lugar
+// de copiar en cada iteración las listas acumuladas de nodos generados e
+// inspeccionados, cada nodo se anota una sola vez, en orden, junto con el
+// punto de cada lista en que termina cada iteración: la memoria es
+// O(nodos generados) y no O(iteraciones * nodos). Las listas acumuladas
+// de la iteración k son los prefijos hasta generated_end[k] (ordenado para
+// el informe) e inspected_end[k]
+struct IterationLog {
+  std::vector<int> generated;              // Nodos generados (numeración del fichero), en orden
+  std::vector<int> inspected;              // Nodos inspeccionados, en orden y sin repetir
+  std::vector<std::size_t> generated_end;  // Nodos generados hasta el final de cada iteración
+  std::vector<std::size_t> inspected_end;  // Nodos inspeccionados hasta el final de cada iteración
   
-  IterationInfo(int iter) : iteration_number(iter) {}
+  std::size_t Size() const {
+    return generated_end.size();
+  }
+  
+  void Clear() {
+    generated.clear();
+    inspected.clear();
+    generated_end.clear();
+    inspected_end.clear();
+  }
 };
 
 // Estructura para el resultado de la búsqueda
 struct SearchResult {
   bool path_found;
+  bool unreachable;       // Origen y destino en componentes conexas distintas (no se exploró)
   std::vector<int> path;
   double total_cost;
-  std::vector<IterationInfo> iterations;
+  TraceLevel trace;        // Nivel con que se registró el recorrido
+  int num_iterations;      // Iteraciones, nodos generados e inspeccionados (kCounters y kFull)
+  long long generated_count;
+  long long inspected_count;
+  IterationLog iterations;  // Solo con kFull
   
-  SearchResult() : path_found(false), total_cost(0.0) {}
+  SearchResult()
+    : path_found(false), unreachable(false), total_cost(0.0), trace(TraceLevel::kNone), num_iterations(0),
+      generated_count(0), inspected_count(0) {}
 };
 
 class SearchAlgorithm {
   public:
-    SearchAlgorithm(const Graph* graph);
+    // Destino que no existe: la búsqueda recorre toda la componente del origen
+    static const int kNoGoal = 0;
+    
+    SearchAlgorithm(const Graph* graph, TraceLevel trace = TraceLevel::kFull);
     virtual ~SearchAlgorithm();
+    // start, goal y los nodos del resultado usan la numeración del fichero
     virtual SearchResult Search(int start, int goal) = 0;
     virtual std::string GetAlgorithmName() const = 0;
     std::string GenerateDetailedReport(const SearchResult& result, int start, int goal) const;
     bool SaveResultToFile(const SearchResult& result, int start, int goal, const std::string& filename) const;
     
   protected:
-    std::vector<int> ReconstructPath(std::shared_ptr<Node> goal_node) const;
+    std::vector<int> ReconstructPath(int goal_node) const;
     double CalculatePathCost(const std::vector<int>& path) const;
     void AddIteration();
     void MarkNodeGenerated(int vertex);
     void MarkNodeInspected(int vertex);
+    void FinishResult(SearchResult& result);
     void Reset(); // Reinicia las estructuras de datos para una nueva búsqueda
 
     const Graph* graph_;
-    std::vector<int> generated_nodes_;      // Nodos generados en la iteración actual
-    std::vector<int> inspected_nodes_;      // Nodos inspeccionados en la iteración actual
-    std::vector<IterationInfo> iterations_;
+    TraceLevel trace_;
+    IterationLog iterations_;               // Nodos generados e inspeccionados en cada iteración (kFull)
     int current_iteration_;
+    long long generated_count_;             // Nodos generados en la búsqueda (kCounters y kFull)
+    long long inspected_count_;             // Nodos inspeccionados en la búsqueda (kCounters y kFull)
+    NodeArena nodes_;                       // Nodos generados en la búsqueda actual
+    VisitedSet explored_;                   // Nodos ya explorados en la búsqueda actual
+    VisitedSet inspected_marks_;            // Nodos ya anotados por MarkNodeInspected (numeración interna)
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,172 @@
+#ifndef TEXT_SCANNER_H
+#define TEXT_SCANNER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Lector de números sobre un buffer de texto en memoria
+ *
+ * Sustituye a std::ifstream >> double para los ficheros de grafos: trabaja
+ * directamente sobre el buffer (por ejemplo, un MappedFile), no depende del
+ * locale y resuelve los casos habituales ("2.236", "-1", "7.0") con un camino
+ * rápido que da exactamente el mismo double que strtod. Los casos raros
+ * (exponentes, mantisas muy largas) se delegan en strtod.
+ */
+class TextScanner {
+  public:
+    TextScanner(const char* begin, const char* end);
+    bool NextInt(int& value);
+    bool NextDistance(double& value);
+    std::string NextWord();
+    bool AtEnd();
+    bool AtTokenBoundary() const;
+    const char* Position() const;
+    static std::size_t CountTokens(const char* begin, const char* end);
+  
+  private:
+    static bool IsSpace(char c);
+    void SkipSpaces();
+    bool ParseSlow(const char* token, double& value);
+    
+    const char* cur_;   // Siguiente carácter por leer
+    const char* end_;   // Fin del buffer
+};
+
+inline TextScanner::TextScanner(const char* begin, const char* end) : cur_(begin), end_(end) {
+}
+
+inline bool TextScanner::IsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+inline void TextScanner::SkipSpaces() {
+  while (cur_ < end_ && IsSpace(*cur_)) {
+    ++cur_;
+  }
+}
+
+// Indica si solo queda espacio en blanco por leer
+inline bool TextScanner::AtEnd() {
+  SkipSpaces();
+  return cur_ == end_;
+}
+
+// Indica si el último número leído ocupaba el token completo
+inline bool TextScanner::AtTokenBoundary() const {
+  return cur_ == end_ || IsSpace(*cur_);
+}
+
+inline const char* TextScanner::Position() const {
+  return cur_;
+}
+
+// Lee el siguiente token como texto (vacío si no quedan tokens)
+inline std::string TextScanner::NextWord() {
+  SkipSpaces();
+  const char* word = cur_;
+  while (cur_ < end_ && !IsSpace(*cur_)) {
+    ++cur_;
+  }
+  return std::string(word, cur_);
+}
+
+/**
+ * @brief Lee la siguiente distancia del fichero de grafo
+ *
+ * Cualquier valor negativo (el centinela -1 de "sin arista") se devuelve como
+ * -1.0 sin llegar a convertirlo. Devuelve false si no hay un número válido.
+ */
+inline bool TextScanner::NextDistance(double& value) {
+  // Potencias de 10 exactas en double
+  static const double kPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  
+  SkipSpaces();
+  const char* token = cur_;
+  const char* p = cur_;
+  
+  bool negative = false;
+  if (p < end_ && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    ++p;
+  }
+  
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int decimals = 0;
+  while (p < end_ && *p >= '0' && *p <= '9') {
+    mantissa = mantissa * 10 + (*p - '0');
+    ++digits;
+    ++p;
+  }
+  if (p < end_ && *p == '.') {
+    ++p;
+    while (p < end_ && *p >= '0' && *p <= '9') {
+      mantissa = mantissa * 10 + (*p - '0');
+      ++digits;
+      ++decimals;
+      ++p;
+    }
+  }
+  
+  if (digits == 0) {
+    return false;
+  }
+  
+  if ((p < end_ && (*p == 'e' || *p == 'E')) || digits > 15 || decimals > 22) {
+    return ParseSlow(token, value);
+  }
+  
+  cur_ = p;
+  if (negative && mantissa != 0) {
+    value = -1.0;
+    return true;
+  }
+  
+  // Mantisa y potencia exactas: una sola división da el redondeo correcto
+  value = static_cast<double>(mantissa) / kPow10[decimals];
+  if (negative) {
+    value = -value;
+  }
+  return true;
+}
+
+inline bool TextScanner::NextInt(int& value) {
+  SkipSpaces();
+  const char* p = cur_;
+  
+  bool negative = false;
+  if (p < end_ && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    ++p;
+  }
+  
+  long long result = 0;
+  const char* digits_begin = p;
+  while (p < end_ && *p >= '0' && *p <= '9') {
+    result = result * 10 + (*p - '0');
+    if (result > 2147483648LL) {
+      return false;
+    }
+    ++p;
+  }
+  
+  if (p == digits_begin) {
+    return false;
+  }
+  
+  result = negative ? -result : result;
+  if (result > 2147483647LL) {
+    return false;
+  }
+  
+  value = static_cast<int>(result);
+  cur_ = p;
+  return true;
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef VISITED_SET_H
+#define VISITED_SET_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @brief Conjunto de vértices visitados con vaciado en O(1)
+ *
+ * Guarda para cada vértice (1-index) la época en que se visitó por última
+ * vez: un vértice está en el conjunto si su marca coincide con la época
+ * actual, así que consultar e insertar es un solo acceso al array y Reset
+ * solo incrementa la época. El array se reserva una vez por tamaño de
+ * grafo y se reutiliza en todas las búsquedas siguientes; solo se vuelve a
+ * poner a cero cuando cambia el número de vértices o la época da la vuelta.
+ */
+class VisitedSet {
+  public:
+    VisitedSet();
+    void Reset(int num_vertices);
+    bool Contains(int vertex) const;
+    void Insert(int vertex);
+
+  private:
+    std::vector<uint32_t> stamps_;  // Época en que se visitó cada vértice (0: nunca)
+    uint32_t epoch_;                // Época de la búsqueda actual
+};
+
+inline VisitedSet::VisitedSet() : epoch_(0) {
+}
+
+// Vacía el conjunto para un grafo de num_vertices vértices
+inline void VisitedSet::Reset(int num_vertices) {
+  if (stamps_.size() != static_cast<std::size_t>(num_vertices) + 1) {
+    stamps_.assign(static_cast<std::size_t>(num_vertices) + 1, 0);
+    epoch_ = 0;
+  }
+  if (++epoch_ == 0) {
+    std::fill(stamps_.begin(), stamps_.end(), 0);
+    epoch_ = 1;
+  }
+}
+
+inline bool VisitedSet::Contains(int vertex) const {
+  return stamps_[vertex] == epoch_;
+}
+
+inline void VisitedSet::Insert(int vertex) {
+  stamps_[vertex] = epoch_;
+}
+
+#endif
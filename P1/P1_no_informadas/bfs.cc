@@ -1,6 +1,6 @@
 #include "bfs.h"
 
-BFS::BFS(const Graph* graph) : SearchAlgorithm(graph) {}
+BFS::BFS(const Graph* graph, TraceLevel trace) : SearchAlgorithm(graph, trace) {}
 
 std::string BFS::GetAlgorithmName() const {
   return "BFS";
@@ -9,62 +9,64 @@ std::string BFS::GetAlgorithmName() const {
 SearchResult BFS::Search(int start, int goal) {
   // Reiniciar estructuras
   Reset();
-  while (!frontier_.empty()) {
-    frontier_.pop();
-  }
-  explored_.clear();
   
   SearchResult result;
   
-  if (!graph_->IsValidVertex(start) || !graph_->IsValidVertex(goal)) {
+  if (!graph_->IsValidVertex(start) || (goal != kNoGoal && !graph_->IsValidVertex(goal))) {
+    return result;
+  }
+  
+  // La búsqueda trabaja con la numeración interna del grafo
+  start = graph_->ToInternal(start);
+  goal = graph_->ToInternal(goal);
+  
+  // Sin camino posible no hace falta explorar la componente del origen
+  if (goal != kNoGoal && !graph_->SameComponent(start, goal)) {
+    result.unreachable = true;
+    FinishResult(result);
     return result;
   }
   
-  std::shared_ptr<Node> start_node = std::make_shared<Node>(start);
-  frontier_.push(start_node);
+  nodes_.Add(start, Node::kNoParent, 0.0);
   MarkNodeGenerated(start);
   
   AddIteration();
   
-  while (!frontier_.empty()) {
-    std::shared_ptr<Node> current_node = frontier_.front();
-    frontier_.pop();
-    
-    int current_vertex = current_node->GetVertex();
+  // La cola de nodos por explorar son los nodos del arena en orden de
+  // generación, desde current_node hasta el último añadido
+  for (int current_node = 0; current_node < nodes_.Size(); ++current_node) {
+    // Copias: añadir vecinos al arena puede mover sus nodos
+    int current_vertex = nodes_[current_node].GetVertex();
+    double current_cost = nodes_[current_node].GetPathCost();
     
-    if (explored_.find(current_vertex) != explored_.end()) {
+    if (explored_.Contains(current_vertex)) {
       continue;
     }
     
-    explored_.insert(current_vertex);
+    explored_.Insert(current_vertex);
     MarkNodeInspected(current_vertex);
     
     if (current_vertex == goal) {
       result.path_found = true;
       result.path = ReconstructPath(current_node);
       result.total_cost = CalculatePathCost(result.path);
-      result.iterations = iterations_;
+      FinishResult(result);
       return result;
     }
     
-    std::vector<int> neighbors = graph_->GetNeighbors(current_vertex);
-    for (int neighbor : neighbors) {
+    graph_->ForEachNeighbor(current_vertex, [&](int neighbor, double edge_cost) {
       // Solo generar y añadir a la frontera si no ha sido explorado
-      if (explored_.find(neighbor) == explored_.end()) {
+      if (!explored_.Contains(neighbor)) {
         MarkNodeGenerated(neighbor);
         
-        double edge_cost = graph_->GetEdgeCost(current_vertex, neighbor);
-        double new_path_cost = current_node->GetPathCost() + edge_cost;
-        
-        std::shared_ptr<Node> neighbor_node = std::make_shared<Node>(neighbor, current_node, new_path_cost);
-        frontier_.push(neighbor_node);
+        nodes_.Add(neighbor, current_node, current_cost + edge_cost);
       }
-    }
+    });
     
     AddIteration();
   }
   
   // No se encontró camino
-  result.iterations = iterations_;
+  FinishResult(result);
   return result;
 }
\ No newline at end of file
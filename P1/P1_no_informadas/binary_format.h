@@ -0,0 +1,70 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Formato binario de grafos para abrirlos con mmap sin parsear
+ *
+ * El fichero empieza con una BinaryGraphHeader seguida de las secciones con
+ * los arrays internos del grafo tal cual están en memoria (CSR con costes
+ * double o cuantizados, filas comprimidas o triángulo empaquetado y mapa de bits, la permutación si se
+ * reordenaron los vértices y la componente conexa de cada vértice). Cada
+ * sección empieza en un múltiplo de kBinarySectionAlignment para poder usarla
+ * directamente desde la proyección.
+ */
+
+// Secciones del fichero binario, en el orden en que se escriben
+enum BinarySection {
+  kSectionOffsets = 0,    // uint64_t[V + 1]
+  kSectionAdjacency,      // int32_t[2E]
+  kSectionWeights,        // double[2E]
+  kSectionPacked,         // float[V(V-1)/2]
+  kSectionBitmap,         // uint64_t[V * words_per_row]
+  kSectionExternalIds,    // int32_t[V]: número original de cada vértice (si está reordenado)
+  kSectionInternalIds,    // int32_t[V]: posición interna de cada número original
+  kSectionComponents,     // int32_t[V]: componente conexa de cada vértice interno
+  kSectionCompressed,     // uint8_t[offsets[V]]: filas codificadas (compressed_row.h)
+  kSectionWeights16,      // uint16_t[2E]: costes CSR cuantizados (coste * 10^weight_decimals)
+  kSectionWeights32,      // uint32_t[2E]: ídem cuando no caben en 16 bits
+  kNumBinarySections
+};
+
+const char kBinaryGraphMagic[8] = {'P', '1', 'G', 'R', 'A', 'P', 'H', '\0'};
+const uint32_t kBinaryGraphVersion = 6;
+const uint32_t kBinaryByteOrderMark = 0x01020304;
+const std::size_t kBinarySectionAlignment = 64;
+
+// Identifica el fichero de texto a partir del que se generó una instantánea
+struct BinarySourceKey {
+  uint64_t size;       // Tamaño en bytes
+  int64_t mtime_ns;    // Fecha de modificación en nanosegundos
+  uint64_t hash;       // BinaryChecksum del contenido
+};
+
+struct BinaryGraphHeader {
+  char magic[8];                                // kBinaryGraphMagic
+  uint32_t version;                             // kBinaryGraphVersion
+  uint32_t byte_order;                          // kBinaryByteOrderMark tal como lo escribió la máquina
+  uint32_t storage;                             // GraphStorage de los arrays guardados
+  int32_t num_vertices;
+  int64_t num_edges;
+  uint64_t words_per_row;                       // Palabras por fila del mapa de bits
+  int64_t weight_decimals;                      // Decimales de los costes cuantizados (-1: double)
+  uint64_t section_offset[kNumBinarySections];  // Posición de cada sección en el fichero
+  uint64_t section_bytes[kNumBinarySections];   // Tamaño de cada sección (0 si no se usa)
+  uint64_t checksum;                            // BinarySectionsChecksum de las secciones
+  BinarySourceKey source;                       // Origen de la instantánea (a 0 si no lo es)
+};
+
+uint64_t BinaryChecksum(const char* data, std::size_t size);
+bool GetFileStamp(const std::string& filename, BinarySourceKey& key);
+bool UpdateBinarySourceKey(const std::string& filename, const BinarySourceKey& key);
+bool HasBinaryGraphMagic(const char* data, std::size_t size);
+bool ValidateBinaryGraphHeader(const BinaryGraphHeader& header, std::size_t file_size, std::string& error);
+uint64_t BinarySectionsChecksum(const char* const sections[], const uint64_t section_bytes[]);
+bool VerifyBinaryGraphFile(const std::string& filename, std::string& error);
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef COMPRESSED_ROW_H
+#define COMPRESSED_ROW_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+/**
+ * @brief Codificación de las filas de la representación comprimida
+ *
+ * Cada fila guarda sus vecinos en orden creciente como diferencias
+ * (gaps) en varint de 7 bits por byte: el primero respecto al propio
+ * vértice en zigzag (puede ser menor) y los demás como distancia al
+ * anterior menos uno. Tras cada vecino va su coste, cuantizado como
+ * entero varint de coste * 10^decimales si todos los costes del grafo se
+ * pueden representar así sin pérdida, o como double de 8 bytes si no.
+ */
+
+// Máximo de decimales con que se intenta cuantizar los costes
+const int kMaxWeightDecimals = 9;
+
+inline double DecimalScale(int decimals) {
+  static const double kScales[kMaxWeightDecimals + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+  };
+  return kScales[decimals];
+}
+
+// Menor número de decimales d tal que todos los costes, guardados como el
+// entero round(coste * 10^d) <= max_value, se recuperan exactamente con
+// entero / 10^d. Devuelve -1 si no hay ninguno
+inline int DetectWeightDecimals(const double* weights, std::size_t count, double max_value) {
+  for (int decimals = 0; decimals <= kMaxWeightDecimals; ++decimals) {
+    double scale = DecimalScale(decimals);
+    bool exact = true;
+    for (std::size_t k = 0; k < count && exact; ++k) {
+      double quantized = std::round(weights[k] * scale);
+      exact = quantized >= 0 && quantized <= max_value && quantized / scale == weights[k];
+    }
+    if (exact) {
+      return decimals;
+    }
+  }
+  return -1;
+}
+
+inline void AppendVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+inline const uint8_t* ReadVarint(const uint8_t* p, uint64_t& value) {
+  value = *p & 0x7f;
+  for (int shift = 7; *p++ & 0x80; shift += 7) {
+    value |= static_cast<uint64_t>(*p & 0x7f) << shift;
+  }
+  return p;
+}
+
+// Como ReadVarint, pero sin leer de end en adelante ni más de 10 bytes (los
+// de un valor de 64 bits). Devuelve nullptr si el varint no termina antes
+inline const uint8_t* ReadVarintBounded(const uint8_t* p, const uint8_t* end, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; p < end && shift < 70; shift += 7) {
+    value |= static_cast<uint64_t>(*p & 0x7f) << shift;
+    if (!(*p++ & 0x80)) {
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+inline uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+#endif
@@ -1,76 +1,1664 @@
 #include "graph.h"
+#include "binary_format.h"
+#include "graph_formats.h"
+#include "text_scanner.h"
 #include <iostream>
 #include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <thread>
 
-Graph::Graph() : num_vertices_(0), num_edges_(0) {
+namespace {
+
+// Densidad a partir de la que se usa el triángulo empaquetado: la mayoría de
+// las posiciones de cada fila son aristas y recorrerla entera cuesta poco más
+const double kPackedDensity = 0.5;
+
+// Densidad a partir de la que CSR (12 bytes por extremo de arista) ocupa más
+// que el triángulo de float (2 bytes por par): se usa entonces el mapa de bits
+const double kBitsetDensity = 1.0 / 6.0;
+
+// Tamaño mínimo de texto por hilo al parsear en paralelo
+const std::size_t kMinParallelChunkBytes = 1 << 20;
+
+// Modificaciones de aristas CSR que se acumulan como mínimo antes de compactar
+const std::size_t kMinCompactionDeltas = 1024;
+
+// Los nombres de segmentos POSIX empiezan por '/'
+std::string SharedSegmentName(const std::string& name) {
+  return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+// Ejecuta task(0) ... task(count - 1), cada una en su propio hilo
+template <typename Task>
+void RunParallel(std::size_t count, Task task) {
+  std::vector<std::thread> workers;
+  for (std::size_t k = 1; k < count; ++k) {
+    workers.push_back(std::thread(task, k));
+  }
+  task(0);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // namespace
+
+Graph::Graph()
+  : num_vertices_(0), storage_(GraphStorage::kCsr), words_per_row_(0), weight_decimals_(-1),
+    memory_(GraphMemory::kDefault), storage_automatic_(false), stats_valid_(false),
+    quantize_weights_(false), components_stale_(false), components_dirty_(false),
+    num_deltas_(0), delta_entries_(0), num_edges_(0) {
 }
 
-Graph::Graph(const std::string& filename) : num_vertices_(0), num_edges_(0) {
-  LoadFromFile(filename);
+Graph::Graph(const std::string& filename, const GraphLoadOptions& options)
+  : num_vertices_(0), storage_(options.storage), words_per_row_(0), weight_decimals_(-1),
+    memory_(GraphMemory::kDefault), storage_automatic_(false), stats_valid_(false),
+    quantize_weights_(false), components_stale_(false), components_dirty_(false),
+    num_deltas_(0), delta_entries_(0), num_edges_(0) {
+  LoadFromFile(filename, options);
 }
 
 Graph::~Graph() {
 }
 
-// Carga el grafo desde archivo
-bool Graph::LoadFromFile(const std::string& filename) {
-  std::ifstream file(filename);
+// Carga el grafo desde archivo. El fichero se proyecta en memoria: si es un
+// fichero binario (ver binary_format.h) sus arrays se usan directamente desde
+// la proyección; si es de texto se usa su instantánea binaria si está al día
+// o, si no, se recorre con TextScanner y se guarda una instantánea nueva.
+// Las instantáneas solo se usan si el formato se deduce de la extensión,
+// porque su nombre no distingue el formato con que se leyó el texto.
+// Con options.shared_name el grafo se toma del segmento de memoria
+// compartida si otro proceso ya lo publicó; si no, se carga del fichero, se
+// publica y se usa desde el segmento, para que no quede ninguna copia privada.
+// Con GraphStorage::kLazy el triángulo de texto se queda proyectado y solo se
+// indexa (LoadLazyText), sin instantánea
+bool Graph::LoadFromFile(const std::string& filename, const GraphLoadOptions& options) {
+  memory_ = options.memory;
+  quantize_weights_ = options.quantize_weights;
+  if (!options.shared_name.empty()) {
+    return LoadShared(filename, options);
+  }
   
-  if (!file.is_open()) {
+  // Los arrays pueden apuntar a la proyección anterior: vaciarlos antes de cerrarla
+  num_vertices_ = 0;
+  num_edges_ = 0;
+  storage_automatic_ = false;
+  stats_valid_ = false;
+  PrepareStorage();
+  
+  GraphFileFormat format = options.format;
+  if (format == GraphFileFormat::kAuto) {
+    format = DetectGraphFileFormat(filename);
+  }
+  
+  GraphStorage storage = options.storage;
+  if (storage == GraphStorage::kLazy && format != GraphFileFormat::kTriangle) {
+    std::cerr << "Aviso: La lectura bajo demanda solo se aplica al triángulo de distancias; se usa auto" << std::endl;
+    storage = GraphStorage::kAuto;
+  }
+  
+  GraphReorder reorder = options.reorder;
+  if (reorder != GraphReorder::kNone && storage != GraphStorage::kCsr && storage != GraphStorage::kAuto) {
+    std::cerr << "Aviso: La reordenación de vértices solo se aplica a la representación csr" << std::endl;
+    reorder = GraphReorder::kNone;
+  }
+  
+  BinarySourceKey key;
+  std::string snapshot_file = filename + "." + GraphStorageName(storage);
+  if (reorder != GraphReorder::kNone) {
+    snapshot_file += "-" + GraphReorderName(reorder);
+  }
+  if (options.quantize_weights) {
+    snapshot_file += "-quantized";
+  }
+  snapshot_file += ".snapshot";
+  bool use_snapshot = options.use_snapshot && options.format == GraphFileFormat::kAuto &&
+                      storage != GraphStorage::kLazy && GetFileStamp(filename, key);
+  if (use_snapshot && LoadSnapshot(filename, snapshot_file, storage, key)) {
+    PlaceArrays();
+    return true;
+  }
+  
+  if (!mapping_.Open(filename)) {
     std::cerr << "Error: No se pudo abrir el archivo " << filename << std::endl;
     return false;
   }
 
-  file >> num_vertices_;
+  if (HasBinaryGraphMagic(mapping_.Data(), mapping_.Size())) {
+    std::string error;
+    if (!LoadBinary(error)) {
+      std::cerr << "Error: Fichero binario de grafo inválido (" << error << "): " << filename << std::endl;
+      return false;
+    }
+    if (options.quantize_weights) {
+      QuantizeWeights();
+    }
+    PlaceArrays();
+    return true;
+  }
+  
+  if (storage == GraphStorage::kLazy) {
+    return LoadLazyText(options.lazy_cache_entries);
+  }
+  
+  bool loaded = format == GraphFileFormat::kTriangle ? LoadText(storage)
+                                                     : LoadSparseText(filename, storage, format);
+  if (loaded) {
+    if (reorder != GraphReorder::kNone) {
+      Reorder(reorder);
+    }
+    if (options.quantize_weights) {
+      QuantizeWeights();
+    }
+    LabelComponents();
+  }
+  if (loaded && use_snapshot) {
+    key.hash = BinaryChecksum(mapping_.Data(), mapping_.Size());
+    WriteSnapshot(snapshot_file, key);
+  }
+  mapping_.Close();
+  if (loaded) {
+    PlaceArrays();
+  }
+  return loaded;
+}
+
+bool Graph::LoadShared(const std::string& filename, const GraphLoadOptions& options) {
+  if (options.memory != GraphMemory::kDefault) {
+    std::cerr << "Aviso: Un grafo compartido se usa desde su segmento; se ignora --memory" << std::endl;
+    memory_ = GraphMemory::kDefault;
+  }
+  if (AttachShared(options.shared_name)) {
+    return true;
+  }
+  
+  GraphLoadOptions private_options = options;
+  private_options.shared_name.clear();
+  private_options.memory = GraphMemory::kDefault;
+  if (!LoadFromFile(filename, private_options)) {
+    return false;
+  }
+  
+  // Si otro proceso se adelantó al publicarlo se usa su segmento; si aún no
+  // está completo se sigue con la copia propia
+  PublishShared(options.shared_name);
+  Graph shared;
+  if (shared.AttachShared(options.shared_name)) {
+    AttachShared(options.shared_name);
+  } else {
+    std::cerr << "Aviso: No se pudo usar el segmento compartido " << options.shared_name
+              << "; se usa una copia propia del grafo" << std::endl;
+  }
+  return true;
+}
+
+// Intenta cargar la instantánea de filename. Vale si el fichero de texto
+// conserva el tamaño y la fecha con que se generó o, si solo cambió la
+// fecha, si su contenido tiene el mismo hash. Cualquier problema con la
+// instantánea se ignora: el grafo se carga entonces desde el texto
+bool Graph::LoadSnapshot(const std::string& filename, const std::string& snapshot_file,
+                         GraphStorage storage, const BinarySourceKey& key) {
+  if (!mapping_.Open(snapshot_file) || mapping_.Size() < sizeof(BinaryGraphHeader)) {
+    mapping_.Close();
+    return false;
+  }
+  
+  BinaryGraphHeader header;
+  std::memcpy(&header, mapping_.Data(), sizeof(header));
+  std::string error;
+  bool fresh = ValidateBinaryGraphHeader(header, mapping_.Size(), error) &&
+               (storage == GraphStorage::kAuto || header.storage == static_cast<uint32_t>(storage)) &&
+               header.source.size == key.size;
+  
+  if (fresh && header.source.mtime_ns != key.mtime_ns) {
+    MappedFile source;
+    fresh = source.Open(filename) && source.Size() == key.size &&
+            BinaryChecksum(source.Data(), source.Size()) == header.source.hash;
+    
+    // Mismo contenido: se actualiza la fecha para no volver a calcular el hash
+    if (fresh) {
+      BinarySourceKey updated = key;
+      updated.hash = header.source.hash;
+      UpdateBinarySourceKey(snapshot_file, updated);
+    }
+  }
+  
+  if (!fresh || !LoadBinary(error)) {
+    num_vertices_ = 0;
+    PrepareStorage();
+    mapping_.Close();
+    return false;
+  }
+  storage_automatic_ = storage == GraphStorage::kAuto;
+  return true;
+}
+
+// Guarda la instantánea en un fichero temporal y la renombra para que otros
+// procesos nunca vean una a medio escribir. Si no se puede, se continúa sin ella
+void Graph::WriteSnapshot(const std::string& snapshot_file, const BinarySourceKey& key) const {
+  std::string temporary = snapshot_file + ".tmp" + std::to_string(getpid());
+  if (!WriteBinary(temporary, key) || std::rename(temporary.c_str(), snapshot_file.c_str()) != 0) {
+    std::remove(temporary.c_str());
+  }
+}
+
+// Lee el formato de texto: número de vértices y triángulo superior de distancias
+bool Graph::LoadText(GraphStorage storage) {
+  mapping_.AdviseSequential();
+  TextScanner scanner(mapping_.Data(), mapping_.Data() + mapping_.Size());
+  num_vertices_ = 0;
+  scanner.NextInt(num_vertices_);
+  
+  if (num_vertices_ <= 0) {
+    std::cerr << "Error: Número de vértices inválido: " << num_vertices_ << std::endl;
+    num_vertices_ = 0;
+    return false;
+  }
+
+  // Con kAuto las aristas se leen como en CSR y la representación se elige
+  // después, con las estadísticas de esas aristas
+  storage_ = storage == GraphStorage::kAuto ? GraphStorage::kCsr : storage;
+  PrepareStorage();
+  
+  // Leer las distancias entre pares de vértices (triángulo superior). En
+  // ficheros grandes se reparte el trabajo entre varios hilos; si algo falla
+  // se repite secuencialmente para informar del error exacto
+  std::vector<GraphEdge> edges;
+  const char* body = scanner.Position();
+  const char* end = mapping_.Data() + mapping_.Size();
+  
+  if (!ParseDistancesParallel(body, end, edges)) {
+    PrepareStorage();
+    edges.clear();
+      
+    ParseChunk chunk = {body, end, 0, TriangleSize(), 0, std::vector<GraphEdge>()};
+    if (!ParseDistances(chunk, false)) {
+      int i, j;
+      TriangleCoordinates(chunk.failed_token, i, j);
+      std::cerr << "Error: No se pudo leer la distancia entre vértices " 
+                << (i + 1) << " y " << (j + 1) << std::endl;
+      num_vertices_ = 0;
+      return false;
+    }
+    edges.swap(chunk.edges);
+  }
+
+  if (storage == GraphStorage::kAuto) {
+    ComputeStats(edges);
+    storage_ = ChooseStorage(stats_);
+    storage_automatic_ = true;
+    PrepareStorage();
+  }
+  BuildStorage(edges);
+  CalculateEdges();
+  
+  return true;
+}
+
+// Lee solo el número de vértices e indexa el triángulo (ver LazyTriangle).
+// La proyección sigue abierta: las distancias se leen de ella al recorrer
+// cada fila. Las componentes no se etiquetan, porque habría que decodificar
+// todas las filas, así que SameComponent no descarta ningún par
+bool Graph::LoadLazyText(std::size_t cache_entries) {
+  TextScanner scanner(mapping_.Data(), mapping_.Data() + mapping_.Size());
+  num_vertices_ = 0;
+  scanner.NextInt(num_vertices_);
   
   if (num_vertices_ <= 0) {
     std::cerr << "Error: Número de vértices inválido: " << num_vertices_ << std::endl;
+    num_vertices_ = 0;
+    mapping_.Close();
+    return false;
+  }
+  
+  storage_ = GraphStorage::kLazy;
+  PrepareStorage();
+  std::string error;
+  if (!lazy_.Build(scanner.Position(), mapping_.Data() + mapping_.Size(), num_vertices_, error)) {
+    std::cerr << "Error: " << error << std::endl;
+    num_vertices_ = 0;
+    mapping_.Close();
+    return false;
+  }
+  lazy_.SetCacheCapacity(cache_entries);
+  CalculateEdges();
+  components_stale_ = true;
+  return true;
+}
+
+// Lee una lista de aristas o un grafo .gr de DIMACS (ver graph_formats.h).
+// Las aristas se guardan directamente en la representación pedida
+bool Graph::LoadSparseText(const std::string& filename, GraphStorage storage, GraphFileFormat format) {
+  mapping_.AdviseSequential();
+  const char* begin = mapping_.Data();
+  const char* end = begin + mapping_.Size();
+  
+  int vertices = 0;
+  std::vector<GraphEdge> edges;
+  std::string error;
+  bool ok = format == GraphFileFormat::kDimacs ? ReadDimacsGraph(begin, end, vertices, edges, error)
+                                               : ReadEdgeList(begin, end, vertices, edges, error);
+  if (!ok) {
+    std::cerr << "Error: " << filename << ": " << error << std::endl;
+    return false;
+  }
+  
+  BuildFromEdges(vertices, edges, storage);
+  return true;
+}
+
+// Construye el grafo a partir de aristas con índices 0-based en [0, num_vertices),
+// por ejemplo las de un generador. Las aristas se normalizan (NormalizeEdges).
+// kLazy no vale aquí: necesita un triángulo de texto proyectado del que leer
+bool Graph::LoadFromEdges(int num_vertices, std::vector<GraphEdge>& edges, GraphStorage storage) {
+  num_vertices_ = 0;
+  num_edges_ = 0;
+  storage_automatic_ = false;
+  stats_valid_ = false;
+  PrepareStorage();
+  mapping_.Close();
+  
+  if (num_vertices <= 0 || storage == GraphStorage::kLazy) {
+    return false;
+  }
+  for (const GraphEdge& edge : edges) {
+    if (edge.from < 0 || edge.to < 0 || edge.from >= num_vertices || edge.to >= num_vertices || !(edge.cost >= 0)) {
+      return false;
+    }
+  }
+  
+  BuildFromEdges(num_vertices, edges, storage);
+  LabelComponents();
+  return true;
+}
+
+void Graph::BuildFromEdges(int num_vertices, std::vector<GraphEdge>& edges, GraphStorage storage) {
+  NormalizeEdges(edges);
+  num_vertices_ = num_vertices;
+  if (storage == GraphStorage::kAuto) {
+    ComputeStats(edges);
+    storage = ChooseStorage(stats_);
+    storage_automatic_ = true;
+  }
+  storage_ = storage;
+  PrepareStorage();
+  BuildStorage(edges);
+  CalculateEdges();
+}
+
+// Usa los arrays del fichero binario proyectado en mapping_ sin copiarlos.
+// Se comprueban la cabecera, el tamaño de las secciones y su contenido
+// (ValidateSections), de modo que un fichero truncado o corrupto se rechaza
+// al cargarlo. La suma de comprobación no se calcula: para eso está
+// VerifyBinaryGraphFile
+bool Graph::LoadBinary(std::string& error) {
+  BinaryGraphHeader header;
+  std::memset(&header, 0, sizeof(header));
+  if (mapping_.Size() >= sizeof(header)) {
+    std::memcpy(&header, mapping_.Data(), sizeof(header));
+  }
+  
+  if (!ValidateBinaryGraphHeader(header, mapping_.Size(), error)) {
+    mapping_.Close();
+    return false;
+  }
+  
+  const char* data = mapping_.Data();
+  num_vertices_ = header.num_vertices;
+  storage_ = static_cast<GraphStorage>(header.storage);
+  
+  std::size_t vertices = static_cast<std::size_t>(num_vertices_);
+  bool valid = false;
+  if (storage_ == GraphStorage::kCsr) {
+    offsets_.Borrow(reinterpret_cast<const uint64_t*>(data + header.section_offset[kSectionOffsets]),
+                    header.section_bytes[kSectionOffsets] / sizeof(uint64_t));
+    adjacency_.Borrow(reinterpret_cast<const int*>(data + header.section_offset[kSectionAdjacency]),
+                      header.section_bytes[kSectionAdjacency] / sizeof(int));
+    weights_.Borrow(reinterpret_cast<const double*>(data + header.section_offset[kSectionWeights]),
+                    header.section_bytes[kSectionWeights] / sizeof(double));
+    weights16_.Borrow(reinterpret_cast<const uint16_t*>(data + header.section_offset[kSectionWeights16]),
+                      header.section_bytes[kSectionWeights16] / sizeof(uint16_t));
+    weights32_.Borrow(reinterpret_cast<const uint32_t*>(data + header.section_offset[kSectionWeights32]),
+                      header.section_bytes[kSectionWeights32] / sizeof(uint32_t));
+    weight_decimals_ = static_cast<int>(header.weight_decimals);
+    
+    // Los costes están en exactamente una de las tres secciones
+    std::size_t entries = adjacency_.Size();
+    int weight_sections = !weights_.Empty() + !weights16_.Empty() + !weights32_.Empty();
+    bool quantized = !weights16_.Empty() || !weights32_.Empty();
+    valid = offsets_.Size() == vertices + 1 && offsets_[vertices] == entries &&
+            (entries == 0 || weight_sections == 1) &&
+            (weights_.Empty() || weights_.Size() == entries) &&
+            (weights16_.Empty() || weights16_.Size() == entries) &&
+            (weights32_.Empty() || weights32_.Size() == entries) &&
+            (quantized ? header.weight_decimals >= 0 && header.weight_decimals <= kMaxWeightDecimals
+                       : header.weight_decimals == -1);
+    
+    external_ids_.Borrow(reinterpret_cast<const int*>(data + header.section_offset[kSectionExternalIds]),
+                         header.section_bytes[kSectionExternalIds] / sizeof(int));
+    internal_ids_.Borrow(reinterpret_cast<const int*>(data + header.section_offset[kSectionInternalIds]),
+                         header.section_bytes[kSectionInternalIds] / sizeof(int));
+    if (!external_ids_.Empty() || !internal_ids_.Empty()) {
+      valid = valid && external_ids_.Size() == vertices && internal_ids_.Size() == vertices;
+    }
+  } else if (storage_ == GraphStorage::kCompressed) {
+    offsets_.Borrow(reinterpret_cast<const uint64_t*>(data + header.section_offset[kSectionOffsets]),
+                    header.section_bytes[kSectionOffsets] / sizeof(uint64_t));
+    compressed_.Borrow(reinterpret_cast<const uint8_t*>(data + header.section_offset[kSectionCompressed]),
+                       header.section_bytes[kSectionCompressed]);
+    weight_decimals_ = static_cast<int>(header.weight_decimals);
+    valid = offsets_.Size() == vertices + 1 && offsets_[vertices] == compressed_.Size() &&
+            header.weight_decimals >= -1 && header.weight_decimals <= kMaxWeightDecimals;
+  } else if (storage_ == GraphStorage::kPackedTriangle || storage_ == GraphStorage::kBitset) {
+    packed_.Borrow(reinterpret_cast<const float*>(data + header.section_offset[kSectionPacked]),
+                   header.section_bytes[kSectionPacked] / sizeof(float));
+    valid = packed_.Size() == TriangleSize();
+    
+    if (storage_ == GraphStorage::kBitset) {
+      words_per_row_ = header.words_per_row;
+      bitmap_.Borrow(reinterpret_cast<const uint64_t*>(data + header.section_offset[kSectionBitmap]),
+                     header.section_bytes[kSectionBitmap] / sizeof(uint64_t));
+      valid = valid && words_per_row_ == (vertices + 63) / 64 &&
+              bitmap_.Size() == words_per_row_ * vertices;
+    }
+  }
+  
+  components_.Borrow(reinterpret_cast<const int*>(data + header.section_offset[kSectionComponents]),
+                     header.section_bytes[kSectionComponents] / sizeof(int));
+  valid = valid && components_.Size() == vertices;
+  
+  if (!valid || !ValidateSections()) {
+    error = valid ? "contenido de las secciones inválido" : "secciones incoherentes";
+    num_vertices_ = 0;
+    PrepareStorage();
+    mapping_.Close();
+    return false;
+  }
+  
+  num_edges_ = static_cast<int>(header.num_edges);
+  return true;
+}
+
+// Comprueba el contenido de los arrays de un fichero binario, ya con el
+// tamaño correcto: desplazamientos de fila que empiezan en 0 y no decrecen,
+// vecinos en [0, V), filas comprimidas que se decodifican dentro de sus
+// límites, bits de relleno del mapa de bits a cero y numeraciones y
+// componentes en [0, V). Recorre una vez todos los arrays, O(V + E)
+bool Graph::ValidateSections() const {
+  std::size_t vertices = static_cast<std::size_t>(num_vertices_);
+  auto valid_index = [vertices](int64_t index) {
+    return index >= 0 && static_cast<uint64_t>(index) < vertices;
+  };
+  
+  if (storage_ == GraphStorage::kCsr || storage_ == GraphStorage::kCompressed) {
+    if (offsets_[0] != 0) {
+      return false;
+    }
+    for (std::size_t i = 0; i < vertices; ++i) {
+      if (offsets_[i] > offsets_[i + 1]) {
+        return false;
+      }
+    }
+  }
+  
+  if (storage_ == GraphStorage::kCsr) {
+    for (std::size_t k = 0; k < adjacency_.Size(); ++k) {
+      if (!valid_index(adjacency_[k])) {
+        return false;
+      }
+    }
+    // Las dos numeraciones deben ser permutaciones inversas
+    for (std::size_t i = 0; i < external_ids_.Size(); ++i) {
+      if (!valid_index(external_ids_[i]) || internal_ids_[external_ids_[i]] != static_cast<int>(i)) {
+        return false;
+      }
+    }
+  }
+  
+  if (storage_ == GraphStorage::kCompressed) {
+    std::size_t cost_bytes = weight_decimals_ >= 0 ? 0 : sizeof(double);
+    for (std::size_t i = 0; i < vertices; ++i) {
+      const uint8_t* bytes = compressed_.Data() + offsets_[i];
+      const uint8_t* end = compressed_.Data() + offsets_[i + 1];
+      int64_t neighbor_index = static_cast<int64_t>(i);
+      bool first = true;
+      while (bytes < end) {
+        uint64_t gap;
+        bytes = ReadVarintBounded(bytes, end, gap);
+        if (bytes == nullptr || (first ? gap / 2 > vertices : gap >= vertices)) {
+          return false;
+        }
+        neighbor_index += first ? ZigZagDecode(gap) : static_cast<int64_t>(gap) + 1;
+        first = false;
+        if (!valid_index(neighbor_index)) {
+          return false;
+        }
+        
+        uint64_t quantized;
+        if (cost_bytes == 0) {
+          bytes = ReadVarintBounded(bytes, end, quantized);
+        } else {
+          bytes = static_cast<std::size_t>(end - bytes) >= cost_bytes ? bytes + cost_bytes : nullptr;
+        }
+        if (bytes == nullptr) {
+          return false;
+        }
+      }
+    }
+  }
+  
+  // ForEachNeighbor trata cada bit activo como un vecino: los de después del
+  // último vértice de cada fila tienen que estar a cero
+  if (storage_ == GraphStorage::kBitset && vertices % 64 != 0) {
+    uint64_t padding = ~uint64_t(0) << (vertices % 64);
+    for (std::size_t i = 0; i < vertices; ++i) {
+      if (bitmap_[(i + 1) * words_per_row_ - 1] & padding) {
+        return false;
+      }
+    }
+  }
+  
+  for (std::size_t i = 0; i < components_.Size(); ++i) {
+    if (!valid_index(components_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Guarda los arrays internos en el formato binario de binary_format.h,
+// tras aplicar las modificaciones de aristas pendientes
+bool Graph::SaveBinary(const std::string& filename) {
+  if (storage_ == GraphStorage::kLazy) {
+    std::cerr << "Error: Un grafo leído bajo demanda no se puede guardar; cárguelo en otra representación" << std::endl;
+    return false;
+  }
+  Compact();
+  BinarySourceKey no_source = {0, 0, 0};
+  if (!WriteBinary(filename, no_source)) {
+    std::cerr << "Error: No se pudo escribir el archivo " << filename << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Rellena la cabecera binaria y la posición en memoria de cada sección.
+// Devuelve el tamaño total que ocupa el grafo en el formato binario
+uint64_t Graph::LayoutBinary(const BinarySourceKey& source, BinaryGraphHeader& header,
+                             const char* sections[]) const {
+  if (components_dirty_) {
+    LabelComponents();
+  }
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kBinaryGraphMagic, sizeof(header.magic));
+  header.version = kBinaryGraphVersion;
+  header.byte_order = kBinaryByteOrderMark;
+  header.storage = static_cast<uint32_t>(storage_);
+  header.num_vertices = num_vertices_;
+  header.num_edges = num_edges_;
+  header.source = source;
+  header.words_per_row = words_per_row_;
+  header.weight_decimals = weight_decimals_;
+  
+  sections[kSectionOffsets] = reinterpret_cast<const char*>(offsets_.Data());
+  sections[kSectionAdjacency] = reinterpret_cast<const char*>(adjacency_.Data());
+  sections[kSectionWeights] = reinterpret_cast<const char*>(weights_.Data());
+  sections[kSectionPacked] = reinterpret_cast<const char*>(packed_.Data());
+  sections[kSectionBitmap] = reinterpret_cast<const char*>(bitmap_.Data());
+  sections[kSectionExternalIds] = reinterpret_cast<const char*>(external_ids_.Data());
+  sections[kSectionInternalIds] = reinterpret_cast<const char*>(internal_ids_.Data());
+  sections[kSectionComponents] = reinterpret_cast<const char*>(components_.Data());
+  sections[kSectionCompressed] = reinterpret_cast<const char*>(compressed_.Data());
+  sections[kSectionWeights16] = reinterpret_cast<const char*>(weights16_.Data());
+  sections[kSectionWeights32] = reinterpret_cast<const char*>(weights32_.Data());
+  header.section_bytes[kSectionOffsets] = offsets_.Size() * sizeof(uint64_t);
+  header.section_bytes[kSectionAdjacency] = adjacency_.Size() * sizeof(int);
+  header.section_bytes[kSectionWeights] = weights_.Size() * sizeof(double);
+  header.section_bytes[kSectionPacked] = packed_.Size() * sizeof(float);
+  header.section_bytes[kSectionBitmap] = bitmap_.Size() * sizeof(uint64_t);
+  header.section_bytes[kSectionExternalIds] = external_ids_.Size() * sizeof(int);
+  header.section_bytes[kSectionInternalIds] = internal_ids_.Size() * sizeof(int);
+  header.section_bytes[kSectionComponents] = components_.Size() * sizeof(int);
+  header.section_bytes[kSectionCompressed] = compressed_.Size();
+  header.section_bytes[kSectionWeights16] = weights16_.Size() * sizeof(uint16_t);
+  header.section_bytes[kSectionWeights32] = weights32_.Size() * sizeof(uint32_t);
+  
+  uint64_t position = sizeof(header);
+  for (int s = 0; s < kNumBinarySections; ++s) {
+    position = (position + kBinarySectionAlignment - 1) / kBinarySectionAlignment * kBinarySectionAlignment;
+    header.section_offset[s] = position;
+    position += header.section_bytes[s];
+  }
+  
+  header.checksum = BinarySectionsChecksum(sections, header.section_bytes);
+  return position;
+}
+
+bool Graph::WriteBinary(const std::string& filename, const BinarySourceKey& source) const {
+  BinaryGraphHeader header;
+  const char* sections[kNumBinarySections];
+  LayoutBinary(source, header, sections);
+  
+  std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  uint64_t written = sizeof(header);
+  const char padding[kBinarySectionAlignment] = {};
+  for (int s = 0; s < kNumBinarySections; ++s) {
+    file.write(padding, header.section_offset[s] - written);
+    file.write(sections[s], header.section_bytes[s]);
+    written = header.section_offset[s] + header.section_bytes[s];
+  }
+  
+  file.close();
+  return !file.fail();
+}
+
+// Copia el grafo, en el formato binario, a un segmento nuevo de memoria
+// compartida. La marca del formato se escribe la última, así que quien
+// intente adjuntarse antes de que termine la copia verá un segmento inválido.
+// Devuelve false si el segmento ya existe, no se puede crear o el grafo se
+// lee bajo demanda (sus filas no están en memoria)
+bool Graph::PublishShared(const std::string& name) {
+  if (storage_ == GraphStorage::kLazy) {
     return false;
   }
+  Compact();
+  std::string segment = SharedSegmentName(name);
+  BinarySourceKey no_source = {0, 0, 0};
+  BinaryGraphHeader header;
+  const char* sections[kNumBinarySections];
+  uint64_t size = LayoutBinary(no_source, header, sections);
+  
+  int fd = shm_open(segment.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  
+  void* target = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+    target = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (target == MAP_FAILED) {
+    shm_unlink(segment.c_str());
+    return false;
+  }
+  
+  char* data = static_cast<char*>(target);
+  for (int s = 0; s < kNumBinarySections; ++s) {
+    std::memcpy(data + header.section_offset[s], sections[s], header.section_bytes[s]);
+  }
+  std::memcpy(data + sizeof(header.magic), reinterpret_cast<const char*>(&header) + sizeof(header.magic),
+              sizeof(header) - sizeof(header.magic));
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  std::memcpy(data, header.magic, sizeof(header.magic));
+  munmap(target, size);
+  return true;
+}
+
+// Sustituye el grafo por el publicado en el segmento name, sin copiarlo: los
+// arrays se toman prestados de la proyección, que comparten todos los
+// procesos adjuntos. Devuelve false si el segmento no existe o no está completo
+bool Graph::AttachShared(const std::string& name) {
+  num_vertices_ = 0;
+  num_edges_ = 0;
+  storage_automatic_ = false;
+  stats_valid_ = false;
+  PrepareStorage();
+  
+  std::string error;
+  if (!mapping_.OpenShared(SharedSegmentName(name)) ||
+      !HasBinaryGraphMagic(mapping_.Data(), mapping_.Size()) || !LoadBinary(error)) {
+    num_vertices_ = 0;
+    PrepareStorage();
+    mapping_.Close();
+    return false;
+  }
+  return true;
+}
+
+// Elimina el segmento name. Los procesos adjuntos conservan su proyección
+// hasta que cargan otro grafo o terminan
+bool Graph::RemoveShared(const std::string& name) {
+  return shm_unlink(SharedSegmentName(name).c_str()) == 0;
+}
+
+// Vacía las estructuras y reserva las del modo de almacenamiento actual
+void Graph::PrepareStorage() {
+  offsets_.Clear();
+  adjacency_.Clear();
+  weights_.Clear();
+  weights16_.Clear();
+  weights32_.Clear();
+  packed_.Clear();
+  bitmap_.Clear();
+  compressed_.Clear();
+  lazy_.Clear();
+  weight_decimals_ = -1;
+  external_ids_.Clear();
+  internal_ids_.Clear();
+  components_.Clear();
+  components_stale_ = false;
+  components_dirty_ = false;
+  deltas_.clear();
+  num_deltas_ = 0;
+  delta_entries_ = 0;
+  words_per_row_ = 0;
+  
+  if (UsesPackedTriangle()) {
+    // El fichero ya viene en el orden del triángulo empaquetado
+    packed_.Assign(TriangleSize(), -1.0f);
+  }
+  if (storage_ == GraphStorage::kBitset) {
+    words_per_row_ = (static_cast<std::size_t>(num_vertices_) + 63) / 64;
+    bitmap_.Assign(words_per_row_ * num_vertices_, 0);
+  }
+}
+
+// Mueve los arrays grandes a regiones reservadas según memory_. Los que
+// vienen de una proyección se copian, así que dejan de depender de ella.
+// Todas las copias se hacen a la vez al final (con first-touch, un único
+// grupo de hilos fijados para la carga entera)
+void Graph::PlaceArrays() {
+  GraphMemoryFill fill(memory_);
+  offsets_.Place(fill);
+  adjacency_.Place(fill);
+  weights_.Place(fill);
+  weights16_.Place(fill);
+  weights32_.Place(fill);
+  packed_.Place(fill);
+  bitmap_.Place(fill);
+  compressed_.Place(fill);
+  external_ids_.Place(fill);
+  internal_ids_.Place(fill);
+  components_.Place(fill);
+  fill.Run();
+}
+
+// Número de pares (i, j) con i < j, es decir, valores del triángulo superior
+std::size_t Graph::TriangleSize() const {
+  return static_cast<std::size_t>(num_vertices_) * (num_vertices_ - 1) / 2;
+}
+
+// Convierte una posición del triángulo empaquetado en su par de vértices
+void Graph::TriangleCoordinates(std::size_t token, int& from_index, int& to_index) const {
+  // La fila i empieza en PackedIndex(i, i + 1): búsqueda binaria de la fila
+  int low = 0;
+  int high = num_vertices_ - 2;
+  while (low < high) {
+    int mid = (low + high + 1) / 2;
+    if (PackedIndex(mid, mid + 1) <= token) {
+      low = mid;
+    } else {
+      high = mid - 1;
+    }
+  }
+  
+  from_index = low;
+  to_index = low + 1 + static_cast<int>(token - PackedIndex(low, low + 1));
+}
+
+// Lee los chunk.num_tokens valores del trozo y los guarda en su posición
+// del triángulo. Con check_token_bounds cada número debe ocupar un token
+// completo, para que la posición coincida con la del recuento previo
+bool Graph::ParseDistances(ParseChunk& chunk, bool check_token_bounds) {
+  if (chunk.num_tokens == 0) {
+    return true;
+  }
+  
+  TextScanner scanner(chunk.begin, chunk.end);
+  int i, j;
+  TriangleCoordinates(chunk.first_token, i, j);
+  
+  for (std::size_t k = 0; k < chunk.num_tokens; ++k) {
+    std::size_t token = chunk.first_token + k;
+    double distance;
+    if (!scanner.NextDistance(distance) || (check_token_bounds && !scanner.AtTokenBoundary())) {
+      chunk.failed_token = token;
+      return false;
+    }
+    
+    if (distance >= 0) {
+      if (UsesPackedTriangle()) {
+        packed_.MutableData()[token] = static_cast<float>(distance);
+        if (storage_ == GraphStorage::kBitset) {
+          SetAdjacencyBit(i, j);
+          SetAdjacencyBit(j, i);
+        }
+      } else {
+        // En CSR solo se guardan las aristas existentes (distancia no negativa)
+        GraphEdge edge = {i, j, distance};
+        chunk.edges.push_back(edge);
+      }
+    }
+    
+    if (++j == num_vertices_) {
+      ++i;
+      j = i + 1;
+    }
+  }
+  
+  return true;
+}
+
+// Parseo en paralelo: el texto se divide en trozos que terminan en salto de
+// línea, se cuentan sus tokens en paralelo y, con la suma prefija de los
+// recuentos, cada hilo sabe en qué posición (i, j) empieza su trozo.
+// Devuelve false si no compensa usar hilos o si el fichero tiene algún
+// problema (el parseo secuencial se encarga entonces de informar)
+bool Graph::ParseDistancesParallel(const char* begin, const char* end, std::vector<GraphEdge>& edges) {
+  std::size_t bytes = static_cast<std::size_t>(end - begin);
+  std::size_t threads = std::min<std::size_t>(std::thread::hardware_concurrency(), bytes / kMinParallelChunkBytes);
+  if (threads <= 1) {
+    return false;
+  }
+  
+  std::vector<ParseChunk> chunks;
+  const char* chunk_begin = begin;
+  for (std::size_t t = 1; t <= threads && chunk_begin < end; ++t) {
+    const char* chunk_end = end;
+    if (t < threads) {
+      chunk_end = std::max(chunk_begin, begin + bytes * t / threads);
+      const void* newline = std::memchr(chunk_end, '\n', end - chunk_end);
+      chunk_end = newline != nullptr ? static_cast<const char*>(newline) + 1 : end;
+    }
+    ParseChunk chunk = {chunk_begin, chunk_end, 0, 0, 0, std::vector<GraphEdge>()};
+    chunks.push_back(chunk);
+    chunk_begin = chunk_end;
+  }
+  
+  RunParallel(chunks.size(), [&chunks](std::size_t c) {
+    chunks[c].num_tokens = TextScanner::CountTokens(chunks[c].begin, chunks[c].end);
+  });
+  
+  // Posición de inicio de cada trozo; lo que sobra tras el triángulo se ignora
+  std::size_t total = TriangleSize();
+  std::size_t first = 0;
+  for (ParseChunk& chunk : chunks) {
+    std::size_t count = chunk.num_tokens;
+    chunk.first_token = first;
+    chunk.num_tokens = first >= total ? 0 : std::min(count, total - first);
+    first += count;
+  }
+  if (first < total) {
+    return false;
+  }
+  
+  std::vector<char> ok(chunks.size(), 0);
+  RunParallel(chunks.size(), [this, &chunks, &ok](std::size_t c) {
+    ok[c] = ParseDistances(chunks[c], true);
+  });
+  
+  for (std::size_t c = 0; c < chunks.size(); ++c) {
+    if (!ok[c]) {
+      return false;
+    }
+  }
+  
+  // Los trozos están en orden, así que las aristas siguen ordenadas por (from, to)
+  for (ParseChunk& chunk : chunks) {
+    edges.insert(edges.end(), chunk.edges.begin(), chunk.edges.end());
+  }
+  return true;
+}
 
-  matrix_.resize(num_vertices_, std::vector<double>(num_vertices_, -1.0));
+// Guarda las aristas (ordenadas por (from, to)) en la representación actual.
+// El triángulo empaquetado se rellena mientras se parsea, así que al cargar
+// el triángulo de distancias solo llegan aristas en modo CSR
+void Graph::BuildStorage(const std::vector<GraphEdge>& edges) {
+  if (storage_ == GraphStorage::kCsr || storage_ == GraphStorage::kCompressed) {
+    BuildCsr(edges);
+    if (storage_ == GraphStorage::kCompressed) {
+      CompressRows();
+    }
+    return;
+  }
   
-  // Establecer diagonal principal a 0
+  float* packed = packed_.MutableData();
+  for (const GraphEdge& edge : edges) {
+    packed[PackedIndex(edge.from, edge.to)] = static_cast<float>(edge.cost);
+    if (storage_ == GraphStorage::kBitset) {
+      SetAdjacencyBit(edge.from, edge.to);
+      SetAdjacencyBit(edge.to, edge.from);
+    }
+  }
+}
+
+// Estadísticas de las aristas normalizadas de un grafo todavía sin construir,
+// en una sola pasada por las aristas
+void Graph::ComputeStats(const std::vector<GraphEdge>& edges) const {
+  std::vector<int> degrees(num_vertices_, 0);
+  bool float_exact = true;
+  for (const GraphEdge& edge : edges) {
+    degrees[edge.from]++;
+    degrees[edge.to]++;
+    float_exact = float_exact && static_cast<double>(static_cast<float>(edge.cost)) == edge.cost;
+  }
+  FinishStats(degrees, static_cast<long long>(edges.size()), float_exact);
+}
+
+// Estadísticas del grafo ya construido, recorriendo los vecinos de cada vértice
+void Graph::ComputeStats() const {
+  std::vector<int> degrees(num_vertices_, 0);
+  bool float_exact = true;
+  long long entries = 0;
   for (int i = 0; i < num_vertices_; ++i) {
-    matrix_[i][i] = 0.0;
+    ForEachNeighbor(i + 1, [&](int, double cost) {
+      degrees[i]++;
+      float_exact = float_exact && static_cast<double>(static_cast<float>(cost)) == cost;
+    });
+    entries += degrees[i];
   }
+  FinishStats(degrees, entries / 2, float_exact);
+}
 
-  // Leer las distancias entre pares de vértices
+void Graph::FinishStats(const std::vector<int>& degrees, long long edges, bool float_exact) const {
+  stats_ = GraphStats();
+  stats_.float_exact = float_exact;
+  double pairs = static_cast<double>(num_vertices_) * (num_vertices_ - 1) / 2;
+  stats_.density = pairs > 0 ? edges / pairs : 0.0;
+  stats_.average_degree = num_vertices_ > 0 ? 2.0 * edges / num_vertices_ : 0.0;
+  stats_.min_degree = degrees.empty() ? 0 : *std::min_element(degrees.begin(), degrees.end());
+  stats_.max_degree = degrees.empty() ? 0 : *std::max_element(degrees.begin(), degrees.end());
+  
+  for (int degree : degrees) {
+    std::size_t bucket = degree == 0 ? 0 : 64 - __builtin_clzll(static_cast<unsigned long long>(degree));
+    if (bucket >= stats_.degree_histogram.size()) {
+      stats_.degree_histogram.resize(bucket + 1, 0);
+    }
+    stats_.degree_histogram[bucket]++;
+  }
+  stats_valid_ = true;
+}
+
+// Representación más rápida para unas estadísticas. Las densas guardan los
+// costes en float, así que solo se eligen si eso no cambia ningún coste. La
+// comprobación es exacta a propósito: costes con decimales como 2.236 no
+// tienen representación exacta en float, de modo que los triángulos del
+// problema (3 decimales) quedan siempre en CSR y conservan los costes
+// exactos en los informes. Con --storage=packed o bitset se pueden forzar
+// las representaciones densas, redondeando los costes a float
+GraphStorage Graph::ChooseStorage(const GraphStats& stats) {
+  if (!stats.float_exact || stats.density < kBitsetDensity) {
+    return GraphStorage::kCsr;
+  }
+  return stats.density >= kPackedDensity ? GraphStorage::kPackedTriangle : GraphStorage::kBitset;
+}
+
+const GraphStats& Graph::GetStats() const {
+  if (!stats_valid_) {
+    ComputeStats();
+  }
+  return stats_;
+}
+
+bool Graph::IsStorageAutomatic() const {
+  return storage_automatic_;
+}
+
+// Construye las filas CSR. Como el grafo es no dirigido, cada arista se
+// guarda en ambas direcciones. Las aristas llegan ordenadas por (from, to),
+// así que cada fila queda ordenada sin tener que ordenarla después.
+void Graph::BuildCsr(const std::vector<GraphEdge>& edges) {
+  offsets_.Assign(num_vertices_ + 1, 0);
+  uint64_t* offsets = offsets_.MutableData();
+  
+  for (const GraphEdge& edge : edges) {
+    offsets[edge.from + 1]++;
+    offsets[edge.to + 1]++;
+  }
   for (int i = 0; i < num_vertices_; ++i) {
-    for (int j = i + 1; j < num_vertices_; ++j) {
-      double distance;
-      if (!(file >> distance)) {
-        std::cerr << "Error: No se pudo leer la distancia entre vértices " 
-                  << (i + 1) << " y " << (j + 1) << std::endl;
-        return false;
+    offsets[i + 1] += offsets[i];
+  }
+  
+  adjacency_.Assign(offsets[num_vertices_], 0);
+  weights_.Assign(offsets[num_vertices_], 0.0);
+  int* adjacency = adjacency_.MutableData();
+  double* weights = weights_.MutableData();
+  
+  std::vector<uint64_t> next(offsets, offsets + num_vertices_);
+  for (const GraphEdge& edge : edges) {
+    uint64_t pos = next[edge.from]++;
+    adjacency[pos] = edge.to;
+    weights[pos] = edge.cost;
+    
+    pos = next[edge.to]++;
+    adjacency[pos] = edge.from;
+    weights[pos] = edge.cost;
+  }
+}
+
+// Codifica las filas CSR recién construidas en compressed_ (ver
+// compressed_row.h) y libera adjacency_ y weights_. Los costes se guardan
+// como enteros con los menos decimales que los representen todos sin
+// pérdida; si no hay tal número de decimales, como double
+void Graph::CompressRows() {
+  weight_decimals_ = DetectWeightDecimals(weights_.Data(), weights_.Size(), 9007199254740991.0);
+  
+  std::vector<uint8_t> bytes;
+  bytes.reserve(adjacency_.Size() * 3);
+  std::vector<uint64_t> offsets(num_vertices_ + 1, 0);
+  double scale = weight_decimals_ >= 0 ? DecimalScale(weight_decimals_) : 1.0;
+  for (int i = 0; i < num_vertices_; ++i) {
+    for (uint64_t k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+      if (k == offsets_[i]) {
+        AppendVarint(bytes, ZigZagEncode(static_cast<int64_t>(adjacency_[k]) - i));
+      } else {
+        AppendVarint(bytes, static_cast<uint64_t>(adjacency_[k] - adjacency_[k - 1] - 1));
       }
       
-      // Como el grafo es no dirigido, establecer ambas direcciones
-      matrix_[i][j] = distance;
-      matrix_[j][i] = distance;
+      if (weight_decimals_ >= 0) {
+        AppendVarint(bytes, static_cast<uint64_t>(std::round(weights_[k] * scale)));
+      } else {
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(weights_.Data() + k);
+        bytes.insert(bytes.end(), raw, raw + sizeof(double));
+      }
     }
+    offsets[i + 1] = bytes.size();
   }
+  
+  bytes.shrink_to_fit();
+  offsets_.Adopt(offsets);
+  compressed_.Adopt(bytes);
+  adjacency_.Clear();
+  weights_.Clear();
+}
 
-  file.close();
+// Sustituye los costes double de las filas CSR por enteros de 16 o 32 bits
+// (coste * 10^weight_decimals_) si hay un número de decimales con el que
+// todos vuelven exactamente al mismo double; si no, los deja como están.
+// Se decodifican con la misma división que se ha comprobado, así que los
+// costes de los caminos no cambian ni en el último bit
+void Graph::QuantizeWeights() {
+  if (storage_ != GraphStorage::kCsr || weights_.Empty()) {
+    return;
+  }
+  
+  int decimals = DetectWeightDecimals(weights_.Data(), weights_.Size(), UINT16_MAX);
+  bool narrow = decimals >= 0;
+  if (!narrow) {
+    decimals = DetectWeightDecimals(weights_.Data(), weights_.Size(), UINT32_MAX);
+  }
+  if (decimals < 0) {
+    return;
+  }
   
+  double scale = DecimalScale(decimals);
+  if (narrow) {
+    std::vector<uint16_t> quantized(weights_.Size());
+    for (std::size_t k = 0; k < quantized.size(); ++k) {
+      quantized[k] = static_cast<uint16_t>(std::round(weights_[k] * scale));
+    }
+    weights16_.Adopt(quantized);
+  } else {
+    std::vector<uint32_t> quantized(weights_.Size());
+    for (std::size_t k = 0; k < quantized.size(); ++k) {
+      quantized[k] = static_cast<uint32_t>(std::round(weights_[k] * scale));
+    }
+    weights32_.Adopt(quantized);
+  }
+  weight_decimals_ = decimals;
+  weights_.Clear();
+}
+
+// Bytes con que se guarda cada coste (2 o 4 si están cuantizados, 8 si son double)
+int Graph::GetWeightBytes() const {
+  if (!weights16_.Empty()) {
+    return 2;
+  }
+  return weights32_.Empty() ? 8 : 4;
+}
+
+int Graph::GetWeightDecimals() const {
+  return weight_decimals_;
+}
+
+// Renumera los vértices según reorder y reconstruye las filas CSR en el
+// nuevo orden. Cada fila conserva el orden de sus vecinos (por número
+// original), de modo que los recorridos visitan los vecinos igual que antes
+void Graph::Reorder(GraphReorder reorder) {
+  if (storage_ != GraphStorage::kCsr || reorder == GraphReorder::kNone) {
+    return;
+  }
+  
+  std::vector<int> order = ComputeOrder(reorder);
+  external_ids_.Assign(num_vertices_, 0);
+  internal_ids_.Assign(num_vertices_, 0);
+  int* external_ids = external_ids_.MutableData();
+  int* internal_ids = internal_ids_.MutableData();
+  for (int i = 0; i < num_vertices_; ++i) {
+    external_ids[i] = order[i];
+    internal_ids[order[i]] = i;
+  }
+  
+  GraphArray<uint64_t> offsets;
+  GraphArray<int> adjacency;
+  GraphArray<double> weights;
+  offsets.Assign(num_vertices_ + 1, 0);
+  adjacency.Assign(adjacency_.Size(), 0);
+  weights.Assign(weights_.Size(), 0.0);
+  uint64_t* new_offsets = offsets.MutableData();
+  int* new_adjacency = adjacency.MutableData();
+  double* new_weights = weights.MutableData();
+  
+  uint64_t pos = 0;
+  for (int i = 0; i < num_vertices_; ++i) {
+    new_offsets[i] = pos;
+    int old_index = order[i];
+    for (uint64_t k = offsets_[old_index]; k < offsets_[old_index + 1]; ++k, ++pos) {
+      new_adjacency[pos] = internal_ids[adjacency_[k]];
+      new_weights[pos] = weights_[k];
+    }
+  }
+  new_offsets[num_vertices_] = pos;
+  
+  std::swap(offsets_, offsets);
+  std::swap(adjacency_, adjacency);
+  std::swap(weights_, weights);
+}
+
+// Orden de los vértices (números originales, 0-based) en la nueva numeración
+std::vector<int> Graph::ComputeOrder(GraphReorder reorder) const {
+  std::vector<int> by_degree(num_vertices_);
+  for (int i = 0; i < num_vertices_; ++i) {
+    by_degree[i] = i;
+  }
+  auto degree = [this](int v) {
+    return offsets_[v + 1] - offsets_[v];
+  };
+  
+  if (reorder == GraphReorder::kDegree) {
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&degree](int a, int b) {
+      return degree(a) > degree(b);
+    });
+    return by_degree;
+  }
+  
+  // Cuthill-McKee: cada componente se recorre en anchura desde su vértice de
+  // menor grado, añadiendo los vecinos nuevos por grado creciente. Al final
+  // se invierte el orden, lo que reduce todavía más el ancho de banda
+  std::stable_sort(by_degree.begin(), by_degree.end(), [&degree](int a, int b) {
+    return degree(a) < degree(b);
+  });
+  
+  std::vector<int> order;
+  order.reserve(num_vertices_);
+  std::vector<char> placed(num_vertices_, 0);
+  for (int root : by_degree) {
+    if (placed[root]) {
+      continue;
+    }
+    placed[root] = 1;
+    order.push_back(root);
+    
+    for (std::size_t head = order.size() - 1; head < order.size(); ++head) {
+      int vertex = order[head];
+      std::size_t first_new = order.size();
+      for (uint64_t k = offsets_[vertex]; k < offsets_[vertex + 1]; ++k) {
+        int neighbor = adjacency_[k];
+        if (!placed[neighbor]) {
+          placed[neighbor] = 1;
+          order.push_back(neighbor);
+        }
+      }
+      std::stable_sort(order.begin() + first_new, order.end(), [&degree](int a, int b) {
+        return degree(a) < degree(b);
+      });
+    }
+  }
+  
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+// Etiqueta las componentes conexas con union-find sobre las aristas. Las
+// etiquetas se numeran en el orden en que aparece cada componente
+void Graph::LabelComponents() const {
+  std::vector<int> parent(num_vertices_);
+  for (int i = 0; i < num_vertices_; ++i) {
+    parent[i] = i;
+  }
+  auto find = [&parent](int v) {
+    while (parent[v] != v) {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+    return v;
+  };
+  
+  for (int i = 0; i < num_vertices_; ++i) {
+    ForEachNeighbor(i + 1, [&](int neighbor, double) {
+      if (neighbor - 1 < i) {
+        return;
+      }
+      int a = find(i);
+      int b = find(neighbor - 1);
+      if (a != b) {
+        parent[std::max(a, b)] = std::min(a, b);
+      }
+    });
+  }
+  
+  // La raíz es siempre el menor vértice de su componente, que se etiqueta antes que el resto
+  components_.Assign(num_vertices_, 0);
+  int* components = components_.MutableData();
+  int next_label = 0;
+  for (int i = 0; i < num_vertices_; ++i) {
+    int root = find(i);
+    components[i] = root == i ? next_label++ : components[root];
+  }
+  components_dirty_ = false;
+}
+
+// Copia a memoria propia los arrays prestados de un fichero proyectado para
+// poder modificarlos; después la proyección ya no hace falta
+void Graph::MakeMutable() {
+  if (!mapping_.IsOpen()) {
+    return;
+  }
+  
+  offsets_.MakeOwned();
+  adjacency_.MakeOwned();
+  weights_.MakeOwned();
+  weights16_.MakeOwned();
+  weights32_.MakeOwned();
+  packed_.MakeOwned();
+  bitmap_.MakeOwned();
+  external_ids_.MakeOwned();
+  internal_ids_.MakeOwned();
+  components_.MakeOwned();
+  mapping_.Close();
+}
+
+// Añade la arista {from, to} o cambia su coste (no negativo). Las filas
+// comprimidas y las leídas bajo demanda son de solo lectura: hay que cargar
+// el grafo en otra representación
+bool Graph::SetEdgeCost(int from, int to, double cost) {
+  if (storage_ == GraphStorage::kCompressed || storage_ == GraphStorage::kLazy) {
+    return false;
+  }
+  if (!IsValidVertex(from) || !IsValidVertex(to) || from == to || !(cost >= 0)) {
+    return false;
+  }
+  
+  MakeMutable();
+  stats_valid_ = false;
+  int from_index = from - 1;
+  int to_index = to - 1;
+  bool added = !HasEdge(from, to);
+  if (added && !components_dirty_ && components_[from_index] != components_[to_index]) {
+    // Une dos componentes: se vuelven a etiquetar en la próxima consulta
+    components_dirty_ = true;
+  }
+  
+  if (UsesPackedTriangle()) {
+    packed_.MutableData()[PackedIndex(from_index, to_index)] = static_cast<float>(cost);
+    if (storage_ == GraphStorage::kBitset) {
+      SetAdjacencyBit(from_index, to_index);
+      SetAdjacencyBit(to_index, from_index);
+    }
+    num_edges_ += added;
+    return true;
+  }
+  
+  SetDelta(from_index, to_index, cost);
+  SetDelta(to_index, from_index, cost);
+  CompactIfNeeded();
   CalculateEdges();
+  return true;
+}
+
+// Elimina la arista {from, to}. Devuelve false si no existe o si el grafo
+// es de solo lectura (comprimido o leído bajo demanda)
+bool Graph::RemoveEdge(int from, int to) {
+  if (storage_ == GraphStorage::kCompressed || storage_ == GraphStorage::kLazy || from == to ||
+      !HasEdge(from, to)) {
+    return false;
+  }
   
+  MakeMutable();
+  stats_valid_ = false;
+  int from_index = from - 1;
+  int to_index = to - 1;
+  
+  if (UsesPackedTriangle()) {
+    packed_.MutableData()[PackedIndex(from_index, to_index)] = -1.0f;
+    if (storage_ == GraphStorage::kBitset) {
+      ClearAdjacencyBit(from_index, to_index);
+      ClearAdjacencyBit(to_index, from_index);
+    }
+    num_edges_--;
+  } else {
+    SetDelta(from_index, to_index, -1.0);
+    SetDelta(to_index, from_index, -1.0);
+    CompactIfNeeded();
+    CalculateEdges();
+  }
+  
+  // Puede partir la componente: se vuelven a etiquetar en la próxima consulta
+  components_dirty_ = true;
   return true;
 }
 
+// Anota en la fila de from_index el nuevo coste de la arista con to_index y
+// actualiza delta_entries_, con el que CalculateEdges cuenta las aristas
+// sin compactar
+void Graph::SetDelta(int from_index, int to_index, double cost) {
+  if (deltas_.empty()) {
+    deltas_.resize(num_vertices_);
+  }
+  
+  std::vector<EdgeDelta>& row = deltas_[from_index];
+  int key = RowKey(to_index);
+  auto it = std::lower_bound(row.begin(), row.end(), key, [this](const EdgeDelta& delta, int target) {
+    return RowKey(delta.neighbor) < target;
+  });
+  
+  // Extremos de arista que gana o pierde la fila respecto a lo que había
+  bool pending = it != row.end() && it->neighbor == to_index;
+  bool existed = pending ? it->cost >= 0 : FindEdge(from_index, to_index) >= 0;
+  delta_entries_ += static_cast<long long>(cost >= 0) - static_cast<long long>(existed);
+  
+  if (pending) {
+    // Eliminar una arista que solo existía en el buffer deja la fila como estaba
+    if (cost < 0 && FindEdge(from_index, to_index) < 0) {
+      row.erase(it);
+      num_deltas_--;
+    } else {
+      it->cost = cost;
+    }
+    return;
+  }
+  
+  EdgeDelta delta = {to_index, cost};
+  row.insert(it, delta);
+  num_deltas_++;
+}
+
+const Graph::EdgeDelta* Graph::FindDelta(int from_index, int to_index) const {
+  if (deltas_.empty()) {
+    return nullptr;
+  }
+  
+  const std::vector<EdgeDelta>& row = deltas_[from_index];
+  int key = RowKey(to_index);
+  auto it = std::lower_bound(row.begin(), row.end(), key, [this](const EdgeDelta& delta, int target) {
+    return RowKey(delta.neighbor) < target;
+  });
+  return it != row.end() && it->neighbor == to_index ? &*it : nullptr;
+}
+
+// Compacta cuando el buffer es grande respecto al grafo: cada compactación
+// cuesta O(V + E), así que se reparte entre muchas modificaciones
+void Graph::CompactIfNeeded() {
+  if (num_deltas_ > std::max(kMinCompactionDeltas, adjacency_.Size() / 8)) {
+    Compact();
+  }
+}
+
+// Vuelca el buffer de modificaciones a los arrays CSR. Cada fila se
+// reconstruye con ForEachNeighbor, así que conserva su orden. Compactar no
+// cambia la conectividad, así que las componentes no se tocan
+void Graph::Compact() {
+  if (num_deltas_ > 0) {
+    std::vector<uint64_t> offsets(num_vertices_ + 1, 0);
+    std::vector<int> adjacency;
+    std::vector<double> weights;
+    adjacency.reserve(adjacency_.Size() + num_deltas_);
+    weights.reserve(adjacency_.Size() + num_deltas_);
+    
+    for (int i = 0; i < num_vertices_; ++i) {
+      offsets[i] = adjacency.size();
+      ForEachNeighbor(i + 1, [&](int neighbor, double cost) {
+        adjacency.push_back(neighbor - 1);
+        weights.push_back(cost);
+      });
+    }
+    offsets[num_vertices_] = adjacency.size();
+    
+    offsets_.Adopt(offsets);
+    adjacency_.Adopt(adjacency);
+    weights_.Adopt(weights);
+    weights16_.Clear();
+    weights32_.Clear();
+    weight_decimals_ = -1;
+    if (quantize_weights_) {
+      QuantizeWeights();
+    }
+    PlaceArrays();
+  }
+  deltas_.clear();
+  num_deltas_ = 0;
+  delta_entries_ = 0;
+}
+
+// Cuenta las aristas en la representación actual. En CSR incluye las
+// modificaciones que aún no se han compactado
 void Graph::CalculateEdges() {
+  if (storage_ == GraphStorage::kCsr) {
+    num_edges_ = static_cast<int>((static_cast<long long>(adjacency_.Size()) + delta_entries_) / 2);
+    return;
+  }
+  
+  if (storage_ == GraphStorage::kLazy) {
+    num_edges_ = static_cast<int>(lazy_.NumEdges());
+    return;
+  }
+  
   num_edges_ = 0;
+  if (storage_ == GraphStorage::kCompressed) {
+    long long entries = 0;
+    for (int i = 1; i <= num_vertices_; ++i) {
+      ForEachNeighbor(i, [&entries](int, double) {
+        entries++;
+      });
+    }
+    num_edges_ = static_cast<int>(entries / 2);
+    return;
+  }
   
-  for (int i = 0; i < num_vertices_; ++i) {
-    for (int j = i + 1; j < num_vertices_; ++j) {
-      if (matrix_[i][j] >= 0) {
-        num_edges_++;
-      }
+  if (storage_ == GraphStorage::kBitset) {
+    // Cada arista aparece una vez en la fila de cada extremo
+    long long bits = 0;
+    for (std::size_t k = 0; k < bitmap_.Size(); ++k) {
+      bits += __builtin_popcountll(bitmap_[k]);
+    }
+    num_edges_ = static_cast<int>(bits / 2);
+    return;
+  }
+  
+  for (std::size_t k = 0; k < packed_.Size(); ++k) {
+    if (packed_[k] >= 0) {
+      num_edges_++;
     }
   }
 }
 
+// Busca to_index en la fila de from_index. Devuelve su posición en
+// adjacency_ o -1 si la arista no existe. Si los vértices están
+// reordenados, las filas siguen ordenadas por número original
+long Graph::FindEdge(int from_index, int to_index) const {
+  const int* first = adjacency_.Data() + offsets_[from_index];
+  const int* last = adjacency_.Data() + offsets_[from_index + 1];
+  const int* it;
+  if (external_ids_.Empty()) {
+    it = std::lower_bound(first, last, to_index);
+  } else {
+    const int* external_ids = external_ids_.Data();
+    it = std::lower_bound(first, last, external_ids[to_index], [external_ids](int neighbor, int target) {
+      return external_ids[neighbor] < target;
+    });
+  }
+  
+  if (it == last || *it != to_index) {
+    return -1;
+  }
+  
+  return static_cast<long>(it - adjacency_.Data());
+}
+
+// Nombre de la representación tal como se escribe en la opción --storage
+std::string GraphStorageName(GraphStorage storage) {
+  switch (storage) {
+    case GraphStorage::kPackedTriangle:
+      return "packed";
+    case GraphStorage::kBitset:
+      return "bitset";
+    case GraphStorage::kCompressed:
+      return "compressed";
+    case GraphStorage::kLazy:
+      return "lazy";
+    case GraphStorage::kAuto:
+      return "auto";
+    default:
+      return "csr";
+  }
+}
+
+bool ParseGraphStorage(const std::string& name, GraphStorage& storage) {
+  if (name == "csr") {
+    storage = GraphStorage::kCsr;
+  } else if (name == "packed") {
+    storage = GraphStorage::kPackedTriangle;
+  } else if (name == "bitset") {
+    storage = GraphStorage::kBitset;
+  } else if (name == "compressed") {
+    storage = GraphStorage::kCompressed;
+  } else if (name == "lazy") {
+    storage = GraphStorage::kLazy;
+  } else if (name == "auto") {
+    storage = GraphStorage::kAuto;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ParseGraphFileFormat(const std::string& name, GraphFileFormat& format) {
+  if (name == "auto") {
+    format = GraphFileFormat::kAuto;
+  } else if (name == "triangle") {
+    format = GraphFileFormat::kTriangle;
+  } else if (name == "edges") {
+    format = GraphFileFormat::kEdgeList;
+  } else if (name == "dimacs") {
+    format = GraphFileFormat::kDimacs;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Nombre de la renumeración tal como se escribe en la opción --reorder
+std::string GraphReorderName(GraphReorder reorder) {
+  switch (reorder) {
+    case GraphReorder::kRcm:
+      return "rcm";
+    case GraphReorder::kDegree:
+      return "degree";
+    default:
+      return "none";
+  }
+}
+
+bool ParseGraphReorder(const std::string& name, GraphReorder& reorder) {
+  if (name == "none") {
+    reorder = GraphReorder::kNone;
+  } else if (name == "rcm") {
+    reorder = GraphReorder::kRcm;
+  } else if (name == "degree") {
+    reorder = GraphReorder::kDegree;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Interpreta una opción de carga de la línea de órdenes
+ *
+ * Opciones comunes a los programas que cargan un grafo: --storage=,
+ * --format=, --reorder=, --memory=, --lazy-cache=, --shared=,
+ * --quantize-weights y --no-snapshot.
+ * @return false si la opción no es de carga o su valor no es válido
+ */
+bool ParseGraphLoadOption(const std::string& option, GraphLoadOptions& options) {
+  std::size_t equals = option.find('=');
+  std::string name = option.substr(0, equals);
+  std::string value = equals == std::string::npos ? "" : option.substr(equals + 1);
+  bool has_value = equals != std::string::npos;
+  
+  if (name == "--storage" && has_value) {
+    return ParseGraphStorage(value, options.storage);
+  }
+  if (name == "--format" && has_value) {
+    return ParseGraphFileFormat(value, options.format);
+  }
+  if (name == "--reorder" && has_value) {
+    return ParseGraphReorder(value, options.reorder);
+  }
+  if (name == "--memory" && has_value) {
+    return ParseGraphMemory(value, options.memory);
+  }
+  if (name == "--lazy-cache" && has_value) {
+    char* end = nullptr;
+    options.lazy_cache_entries = std::strtoull(value.c_str(), &end, 10);
+    return !value.empty() && *end == '\0';
+  }
+  if (name == "--shared" && has_value) {
+    options.shared_name = value;
+    return !value.empty();
+  }
+  if (option == "--quantize-weights") {
+    options.quantize_weights = true;
+    return true;
+  }
+  if (option == "--no-snapshot") {
+    options.use_snapshot = false;
+    return true;
+  }
+  return false;
+}
+
+bool Graph::UsesPackedTriangle() const {
+  return storage_ == GraphStorage::kPackedTriangle || storage_ == GraphStorage::kBitset;
+}
+
+// La escritura es atómica porque varios hilos de carga pueden tocar la misma palabra
+void Graph::SetAdjacencyBit(int from_index, int to_index) {
+  __atomic_fetch_or(bitmap_.MutableData() + from_index * words_per_row_ + to_index / 64,
+                    uint64_t(1) << (to_index % 64), __ATOMIC_RELAXED);
+}
+
+void Graph::ClearAdjacencyBit(int from_index, int to_index) {
+  bitmap_.MutableData()[from_index * words_per_row_ + to_index / 64] &= ~(uint64_t(1) << (to_index % 64));
+}
+
+bool Graph::TestAdjacencyBit(int from_index, int to_index) const {
+  return (bitmap_[from_index * words_per_row_ + to_index / 64] >> (to_index % 64)) & 1;
+}
+
+GraphStorage Graph::GetStorage() const {
+  return storage_;
+}
+
+// Índice y caché de filas de un grafo kLazy (vacíos en las demás representaciones)
+const LazyTriangle& Graph::GetLazyRows() const {
+  return lazy_;
+}
+
 int Graph::GetNumVertices() const {
   return num_vertices_;
 }
@@ -84,7 +1672,37 @@ double Graph::GetEdgeCost(int from, int to) const {
     return -1.0;
   }
   
-  return matrix_[from - 1][to - 1];
+  if (from == to) {
+    return 0.0;
+  }
+  
+  if (UsesPackedTriangle()) {
+    float cost = packed_[PackedIndex(from - 1, to - 1)];
+    return cost >= 0 ? static_cast<double>(cost) : -1.0;
+  }
+  
+  if (storage_ == GraphStorage::kLazy) {
+    return lazy_.ReadCost(from - 1, to - 1);
+  }
+  
+  if (storage_ == GraphStorage::kCompressed) {
+    // Las filas comprimidas solo se pueden recorrer en orden: O(grado)
+    double found = -1.0;
+    ForEachNeighbor(from, [to, &found](int neighbor, double cost) {
+      if (neighbor == to) {
+        found = cost;
+      }
+    });
+    return found;
+  }
+  
+  const EdgeDelta* delta = FindDelta(from - 1, to - 1);
+  if (delta != nullptr) {
+    return delta->cost >= 0 ? delta->cost : -1.0;
+  }
+  
+  long pos = FindEdge(from - 1, to - 1);
+  return pos < 0 ? -1.0 : CsrWeight(pos);
 }
 
 bool Graph::HasEdge(int from, int to) const {
@@ -92,24 +1710,37 @@ bool Graph::HasEdge(int from, int to) const {
     return false;
   }
   
-  return matrix_[from - 1][to - 1] >= 0;
-}
-
-std::vector<int> Graph::GetNeighbors(int vertex) const {
-  std::vector<int> neighbors;
+  if (from == to) {
+    return true;
+  }
   
-  if (!IsValidVertex(vertex)) {
-    return neighbors;
+  if (storage_ == GraphStorage::kBitset) {
+    return TestAdjacencyBit(from - 1, to - 1);
   }
   
-  int vertex_index = vertex - 1;
+  if (storage_ == GraphStorage::kPackedTriangle) {
+    return packed_[PackedIndex(from - 1, to - 1)] >= 0;
+  }
   
-  for (int i = 0; i < num_vertices_; ++i) {
-    if (i != vertex_index && matrix_[vertex_index][i] >= 0) {
-      neighbors.push_back(i + 1);
-    }
+  if (storage_ == GraphStorage::kCompressed || storage_ == GraphStorage::kLazy) {
+    return GetEdgeCost(from, to) >= 0;
   }
   
+  const EdgeDelta* delta = FindDelta(from - 1, to - 1);
+  if (delta != nullptr) {
+    return delta->cost >= 0;
+  }
+  
+  return FindEdge(from - 1, to - 1) >= 0;
+}
+
+std::vector<int> Graph::GetNeighbors(int vertex) const {
+  std::vector<int> neighbors;
+  
+  ForEachNeighbor(vertex, [&neighbors](int neighbor, double) {
+    neighbors.push_back(neighbor);
+  });
+  
   return neighbors;
 }
 
@@ -119,19 +1750,67 @@ bool Graph::IsValidVertex(int vertex) const {
 
 std::string Graph::ToString() const {
   std::ostringstream oss;
-  oss << "Grafo con " << num_vertices_ << " vértices y " << num_edges_ << " aristas\n";
-  oss << "Matriz de adyacencia:\n";
-  
-  for (int i = 0; i < num_vertices_; ++i) {
-    for (int j = 0; j < num_vertices_; ++j) {
-      oss << std::fixed << std::setprecision(3) << std::setw(8) << matrix_[i][j] << " ";
-    }
-    oss << "\n";
-  }
-  
+  WriteMatrix(oss);
   return oss.str();
 }
 
 void Graph::PrintMatrix() const {
-  std::cout << ToString();
-}
\ No newline at end of file
+  WriteMatrix(std::cout);
+}
+
+/**
+ * @brief Escribe la matriz de adyacencia (o parte de ella) directamente en out
+ *
+ * Cada fila se forma en un buffer del ancho de la ventana a partir de los
+ * vecinos del vértice y se escribe antes de pasar a la siguiente, así que la
+ * memoria no depende del número de filas. Con window.edges_only solo se
+ * escriben las aristas existentes, en O(aristas de la ventana) por fila en
+ * lugar de O(columnas).
+ */
+void Graph::WriteMatrix(std::ostream& out, const MatrixWindow& window) const {
+  out << "Grafo con " << num_vertices_ << " vértices y " << num_edges_ << " aristas\n";
+  
+  // Filas y columnas en la numeración del fichero
+  int first_row = std::max(window.first_row, 1);
+  int last_row = window.last_row > 0 ? std::min(window.last_row, num_vertices_) : num_vertices_;
+  int first_column = std::max(window.first_column, 1);
+  int last_column = window.last_column > 0 ? std::min(window.last_column, num_vertices_) : num_vertices_;
+  if (window.edges_only) {
+    out << "Aristas (fila columna coste):\n";
+  } else {
+    out << "Matriz de adyacencia:\n";
+  }
+  
+  std::vector<double> row(last_column >= first_column ? last_column - first_column + 1 : 0);
+  std::string line;
+  char cell[64];
+  for (int i = first_row; i <= last_row && !row.empty(); ++i) {
+    line.clear();
+    if (window.edges_only) {
+      ForEachNeighbor(ToInternal(i), [&](int neighbor, double cost) {
+        int j = ToExternal(neighbor);
+        if (j >= first_column && j <= last_column) {
+          std::snprintf(cell, sizeof(cell), "%d %d %.3f\n", i, j, cost);
+          line += cell;
+        }
+      });
+    } else {
+      std::fill(row.begin(), row.end(), -1.0);
+      if (i >= first_column && i <= last_column) {
+        row[i - first_column] = 0.0;
+      }
+      ForEachNeighbor(ToInternal(i), [&](int neighbor, double cost) {
+        int j = ToExternal(neighbor);
+        if (j >= first_column && j <= last_column) {
+          row[j - first_column] = cost;
+        }
+      });
+      for (double cost : row) {
+        std::snprintf(cell, sizeof(cell), "%8.3f ", cost);
+        line += cell;
+      }
+      line += '\n';
+    }
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+  }
+}
@@ -0,0 +1,148 @@
+#ifndef GRAPH_ARRAY_H
+#define GRAPH_ARRAY_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "graph_memory.h"
+
+/**
+ * @brief Array contiguo de la representación interna del grafo
+ *
+ * Puede ser propio (memoria reservada por el grafo al construirlo) o
+ * prestado: una vista de solo lectura sobre memoria que mantiene viva otro
+ * objeto, como la proyección de un fichero binario. Así el grafo puede usar
+ * los datos de un fichero proyectado sin copiarlos. Place mueve los datos a
+ * una región con páginas grandes y la ubicación NUMA de una GraphMemory
+ * (graph_memory.h); el array sigue siendo propio y modificable.
+ */
+template <typename T>
+class GraphArray {
+  public:
+    GraphArray();
+    void Assign(std::size_t size, const T& value);
+    void Borrow(const T* data, std::size_t size);
+    void Adopt(std::vector<T>& data);
+    void MakeOwned();
+    void Place(GraphMemoryFill& fill);
+    void Clear();
+    bool Empty() const;
+    std::size_t Size() const;
+    const T* Data() const;
+    T* MutableData();
+    const T& operator[](std::size_t index) const;
+  
+  private:
+    std::vector<T> owned_;   // Datos propios (vacío si el array es prestado o está en region_)
+    const T* borrowed_;      // Datos prestados (nullptr si el array es propio)
+    GraphMemoryRegion region_;   // Datos propios movidos por Place
+    T* placed_;              // Inicio de region_ (nullptr si no se usa)
+    std::size_t size_;       // Número de elementos
+};
+
+template <typename T>
+GraphArray<T>::GraphArray() : borrowed_(nullptr), placed_(nullptr), size_(0) {
+}
+
+// Reserva un array propio de size elementos inicializados a value
+template <typename T>
+void GraphArray<T>::Assign(std::size_t size, const T& value) {
+  borrowed_ = nullptr;
+  region_.Release();
+  placed_ = nullptr;
+  owned_.assign(size, value);
+  size_ = size;
+}
+
+// Usa data como contenido sin copiarlo; quien presta debe mantenerlo vivo
+template <typename T>
+void GraphArray<T>::Borrow(const T* data, std::size_t size) {
+  std::vector<T>().swap(owned_);
+  region_.Release();
+  placed_ = nullptr;
+  borrowed_ = data;
+  size_ = size;
+}
+
+// Toma el contenido de data sin copiarlo (data queda vacío)
+template <typename T>
+void GraphArray<T>::Adopt(std::vector<T>& data) {
+  borrowed_ = nullptr;
+  region_.Release();
+  placed_ = nullptr;
+  owned_.swap(data);
+  std::vector<T>().swap(data);
+  size_ = owned_.size();
+}
+
+// Copia los datos prestados para poder modificarlos
+template <typename T>
+void GraphArray<T>::MakeOwned() {
+  if (borrowed_ != nullptr) {
+    owned_.assign(borrowed_, borrowed_ + size_);
+    borrowed_ = nullptr;
+  }
+}
+
+// Mueve los datos (propios o prestados) a una región reservada según la
+// política de fill. La copia queda anotada en fill y no se hace hasta
+// fill.Run(), que también libera entonces los datos propios anteriores. Los
+// arrays de menos de una página grande se quedan donde están, igual que si
+// no se puede reservar la región
+template <typename T>
+void GraphArray<T>::Place(GraphMemoryFill& fill) {
+  std::size_t bytes = size_ * sizeof(T);
+  if (fill.GetPolicy() == GraphMemory::kDefault || placed_ != nullptr || bytes < kHugePageBytes) {
+    return;
+  }
+  
+  GraphMemoryRegion region;
+  if (!region.Allocate(bytes, fill.GetPolicy())) {
+    return;
+  }
+  fill.Add(region.Data(), Data(), bytes);
+  fill.Keep(owned_);
+  borrowed_ = nullptr;
+  region_ = std::move(region);
+  placed_ = static_cast<T*>(region_.Data());
+}
+
+template <typename T>
+void GraphArray<T>::Clear() {
+  std::vector<T>().swap(owned_);
+  borrowed_ = nullptr;
+  region_.Release();
+  placed_ = nullptr;
+  size_ = 0;
+}
+
+template <typename T>
+bool GraphArray<T>::Empty() const {
+  return size_ == 0;
+}
+
+template <typename T>
+std::size_t GraphArray<T>::Size() const {
+  return size_;
+}
+
+template <typename T>
+const T* GraphArray<T>::Data() const {
+  if (borrowed_ != nullptr) {
+    return borrowed_;
+  }
+  return placed_ != nullptr ? placed_ : owned_.data();
+}
+
+// Acceso de escritura: solo válido para arrays propios
+template <typename T>
+T* GraphArray<T>::MutableData() {
+  return placed_ != nullptr ? placed_ : owned_.data();
+}
+
+template <typename T>
+const T& GraphArray<T>::operator[](std::size_t index) const {
+  return Data()[index];
+}
+
+#endif
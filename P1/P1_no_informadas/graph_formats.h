@@ -0,0 +1,50 @@
+#ifndef GRAPH_FORMATS_H
+#define GRAPH_FORMATS_H
+
+#include <vector>
+#include <string>
+#include "graph.h"
+
+/**
+ * @brief Lectores de formatos de grafos dispersos
+ *
+ * Además del triángulo de distancias del problema, Graph puede cargar grafos
+ * grandes y dispersos en los formatos habituales de los bancos de pruebas:
+ *
+ *  - Lista de aristas: una arista "u v [coste]" por línea (coste 1 si se
+ *    omite), vértices 1-index; las líneas que empiezan por '#' o '%' son
+ *    comentarios. El número de vértices es el mayor identificador leído.
+ *  - DIMACS (9th Implementation Challenge): fichero .gr con una línea
+ *    "p sp <vértices> <arcos>" y un arco "a u v w" por línea, y ficheros de
+ *    consultas .ss ("s origen") y .p2p ("q origen destino"). Las líneas "c"
+ *    son comentarios.
+ *
+ * Todos trabajan sobre un buffer en memoria (normalmente un MappedFile) y
+ * devuelven las aristas con índices 0-based. Los arcos de DIMACS son
+ * dirigidos; como Graph es no dirigido, NormalizeEdges los junta.
+ *
+ * Los escritores hacen el camino inverso (incluido el triángulo de
+ * distancias) a partir de aristas normalizadas, escribiendo cada coste con
+ * decimals decimales.
+ */
+
+// Consulta de un fichero .ss o .p2p (vértices 1-index)
+struct GraphQuery {
+  int start;
+  int goal;        // 0 en las consultas .ss, que no tienen destino
+};
+
+GraphFileFormat DetectGraphFileFormat(const std::string& filename);
+bool ReadEdgeList(const char* begin, const char* end, int& num_vertices,
+                  std::vector<GraphEdge>& edges, std::string& error);
+bool ReadDimacsGraph(const char* begin, const char* end, int& num_vertices,
+                     std::vector<GraphEdge>& edges, std::string& error);
+bool ReadDimacsQueries(const char* begin, const char* end, std::vector<GraphQuery>& queries,
+                       std::string& error);
+void NormalizeEdges(std::vector<GraphEdge>& edges);
+bool WriteTriangle(const std::string& filename, int num_vertices, const std::vector<GraphEdge>& edges, int decimals);
+bool WriteEdgeList(const std::string& filename, const std::vector<GraphEdge>& edges, int decimals);
+bool WriteDimacsGraph(const std::string& filename, int num_vertices, const std::vector<GraphEdge>& edges,
+                      int decimals);
+
+#endif
@@ -0,0 +1,242 @@
+#include "graph_generator.h"
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Real uniforme en [0, 1) con los 53 bits altos del generador
+double Uniform01(std::mt19937_64& rng) {
+  return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Sortea costes según la distribución elegida, redondeados a los decimales pedidos
+class WeightSampler {
+  public:
+    WeightSampler(const GeneratorOptions& options, std::mt19937_64& rng)
+      : options_(options), rng_(rng), scale_(std::pow(10.0, options.decimals)) {}
+    
+    // distance_ratio (en [0, 1]) solo se usa con WeightDistribution::kDistance
+    double Next(double distance_ratio) {
+      double weight = 1.0;
+      switch (options_.weights) {
+        case WeightDistribution::kUniform:
+          weight = options_.min_weight + (options_.max_weight - options_.min_weight) * Uniform01(rng_);
+          break;
+        case WeightDistribution::kInteger: {
+          double low = std::ceil(options_.min_weight);
+          double high = std::floor(options_.max_weight);
+          return low + std::floor((high - low + 1) * Uniform01(rng_));
+        }
+        case WeightDistribution::kDistance:
+          weight = options_.min_weight + (options_.max_weight - options_.min_weight) * distance_ratio;
+          break;
+        case WeightDistribution::kUnit:
+          return 1.0;
+      }
+      // Mantisa entera entre potencia de 10: el mismo double que da leer el texto
+      return std::round(weight * scale_) / scale_;
+    }
+  
+  private:
+    const GeneratorOptions& options_;
+    std::mt19937_64& rng_;
+    double scale_;
+};
+
+// G(V, p) en O(V + E): en lugar de sortear cada par se sortea cuántos pares
+// se saltan hasta la siguiente arista (distribución geométrica)
+void GenerateErdosRenyi(const GeneratorOptions& options, std::mt19937_64& rng, WeightSampler& sampler,
+                        std::vector<GraphEdge>& edges) {
+  uint64_t n = static_cast<uint64_t>(options.num_vertices);
+  uint64_t total = n * (n - 1) / 2;
+  double p = options.density;
+  if (p <= 0 || total == 0) {
+    return;
+  }
+  
+  double log_q = std::log(1.0 - p);
+  uint64_t k = 0;           // Siguiente par candidato, en el orden del triángulo superior
+  int i = 0;
+  uint64_t row_start = 0;   // Pares (i, i+1) ... (i, V-1) = [row_start, row_end)
+  uint64_t row_end = n - 1;
+  while (k < total) {
+    if (p < 1) {
+      double skip = std::floor(std::log(1.0 - Uniform01(rng)) / log_q);
+      if (skip >= static_cast<double>(total - k)) {
+        break;
+      }
+      k += static_cast<uint64_t>(skip);
+    }
+    
+    while (k >= row_end) {
+      row_start = row_end;
+      ++i;
+      row_end += n - i - 1;
+    }
+    GraphEdge edge = {i, i + 1 + static_cast<int>(k - row_start), sampler.Next(0.0)};
+    edges.push_back(edge);
+    ++k;
+  }
+}
+
+// Grafo geométrico aleatorio: con p = pi r^2, cada par está a distancia menor
+// que r con probabilidad ~p (menos en los bordes). Los puntos se reparten en
+// celdas de lado >= r, así que solo se comparan los de celdas vecinas
+void GenerateGeometric(const GeneratorOptions& options, std::mt19937_64& rng, WeightSampler& sampler,
+                       std::vector<GraphEdge>& edges) {
+  int n = options.num_vertices;
+  double radius = std::sqrt(options.density / kPi);
+  if (radius <= 0) {
+    return;
+  }
+  
+  std::vector<double> x(n);
+  std::vector<double> y(n);
+  for (int v = 0; v < n; ++v) {
+    x[v] = Uniform01(rng);
+    y[v] = Uniform01(rng);
+  }
+  
+  int cells = static_cast<int>(std::min(1.0 / radius, std::sqrt(static_cast<double>(n)) + 1));
+  cells = std::max(cells, 1);
+  auto cell_of = [cells](double coordinate) {
+    return std::min(static_cast<int>(coordinate * cells), cells - 1);
+  };
+  
+  // Vértices de cada celda (ordenación por recuento)
+  std::vector<int> cell_start(cells * cells + 1, 0);
+  for (int v = 0; v < n; ++v) {
+    cell_start[cell_of(y[v]) * cells + cell_of(x[v]) + 1]++;
+  }
+  for (int c = 0; c < cells * cells; ++c) {
+    cell_start[c + 1] += cell_start[c];
+  }
+  std::vector<int> cell_vertices(n);
+  std::vector<int> next(cell_start.begin(), cell_start.end() - 1);
+  for (int v = 0; v < n; ++v) {
+    cell_vertices[next[cell_of(y[v]) * cells + cell_of(x[v])]++] = v;
+  }
+  
+  // Cada par de celdas vecinas se visita una sola vez: la propia y cuatro de sus ocho vecinas
+  const int kNeighborCells[5][2] = {{0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+  for (int cy = 0; cy < cells; ++cy) {
+    for (int cx = 0; cx < cells; ++cx) {
+      int cell = cy * cells + cx;
+      for (const int* offset : kNeighborCells) {
+        int ox = cx + offset[0];
+        int oy = cy + offset[1];
+        if (ox < 0 || ox >= cells || oy >= cells) {
+          continue;
+        }
+        int other = oy * cells + ox;
+        for (int a = cell_start[cell]; a < cell_start[cell + 1]; ++a) {
+          int b_first = other == cell ? a + 1 : cell_start[other];
+          for (int b = b_first; b < cell_start[other + 1]; ++b) {
+            int u = cell_vertices[a];
+            int v = cell_vertices[b];
+            double distance = std::hypot(x[u] - x[v], y[u] - y[v]);
+            if (distance < radius) {
+              GraphEdge edge = {std::min(u, v), std::max(u, v), sampler.Next(distance / radius)};
+              edges.push_back(edge);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Rejilla de filas x columnas casi cuadrada numerada por filas
+void GenerateGrid(const GeneratorOptions& options, std::mt19937_64& rng, WeightSampler& sampler,
+                  std::vector<GraphEdge>& edges) {
+  int n = options.num_vertices;
+  int rows = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(n))));
+  int cols = (n + rows - 1) / rows;
+  
+  for (int v = 0; v < n; ++v) {
+    int neighbors[2] = {(v % cols) + 1 < cols ? v + 1 : n, v + cols};
+    for (int w : neighbors) {
+      if (w < n && (options.density >= 1 || Uniform01(rng) < options.density)) {
+        GraphEdge edge = {v, w, sampler.Next(0.0)};
+        edges.push_back(edge);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool GenerateGraphEdges(const GeneratorOptions& options, std::vector<GraphEdge>& edges, std::string& error) {
+  edges.clear();
+  if (options.num_vertices <= 0) {
+    error = "el número de vértices debe ser positivo";
+    return false;
+  }
+  if (!(options.density >= 0 && options.density <= 1)) {
+    error = "la densidad debe estar entre 0 y 1";
+    return false;
+  }
+  if (!(options.min_weight >= 0 && options.min_weight <= options.max_weight)) {
+    error = "los costes deben cumplir 0 <= mínimo <= máximo";
+    return false;
+  }
+  if (options.weights == WeightDistribution::kInteger &&
+      std::ceil(options.min_weight) > std::floor(options.max_weight)) {
+    error = "no hay ningún entero entre el coste mínimo y el máximo";
+    return false;
+  }
+  if (options.decimals < 0 || options.decimals > 9) {
+    error = "los decimales deben estar entre 0 y 9";
+    return false;
+  }
+  if (options.weights == WeightDistribution::kDistance && options.family != GraphFamily::kGeometric) {
+    error = "los costes por distancia solo tienen sentido en grafos geométricos";
+    return false;
+  }
+  
+  std::mt19937_64 rng(options.seed);
+  WeightSampler sampler(options, rng);
+  switch (options.family) {
+    case GraphFamily::kErdosRenyi:
+      GenerateErdosRenyi(options, rng, sampler, edges);
+      break;
+    case GraphFamily::kGeometric:
+      GenerateGeometric(options, rng, sampler, edges);
+      break;
+    case GraphFamily::kGrid:
+      GenerateGrid(options, rng, sampler, edges);
+      break;
+  }
+  return true;
+}
+
+bool ParseGraphFamily(const std::string& name, GraphFamily& family) {
+  if (name == "er") {
+    family = GraphFamily::kErdosRenyi;
+  } else if (name == "geometric") {
+    family = GraphFamily::kGeometric;
+  } else if (name == "grid") {
+    family = GraphFamily::kGrid;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ParseWeightDistribution(const std::string& name, WeightDistribution& weights) {
+  if (name == "uniform") {
+    weights = WeightDistribution::kUniform;
+  } else if (name == "integer") {
+    weights = WeightDistribution::kInteger;
+  } else if (name == "unit") {
+    weights = WeightDistribution::kUnit;
+  } else if (name == "distance") {
+    weights = WeightDistribution::kDistance;
+  } else {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,55 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "graph.h"
+
+// Familias de grafos sintéticos
+enum class GraphFamily {
+  kErdosRenyi,   // G(V, p): cada par de vértices es arista con probabilidad density
+  kGeometric,    // Puntos al azar en el cuadrado unidad unidos si están a distancia < r
+  kGrid          // Rejilla de 4 vecinos de la que se conserva cada arista con probabilidad density
+};
+
+// Distribución de los costes de las aristas
+enum class WeightDistribution {
+  kUniform,      // Real uniforme en [min_weight, max_weight]
+  kInteger,      // Entero uniforme en [min_weight, max_weight]
+  kUnit,         // Todas las aristas cuestan 1
+  kDistance      // Proporcional a la distancia entre los puntos (solo kGeometric)
+};
+
+// Parámetros del generador
+struct GeneratorOptions {
+  GraphFamily family;
+  int num_vertices;
+  double density;              // Probabilidad de arista (en kGeometric fija el radio: p = pi r^2)
+  WeightDistribution weights;
+  double min_weight;
+  double max_weight;
+  int decimals;                // Decimales con que se redondean los costes
+  uint64_t seed;
+  
+  GeneratorOptions()
+    : family(GraphFamily::kErdosRenyi), num_vertices(1000), density(0.01),
+      weights(WeightDistribution::kUniform), min_weight(0.5), max_weight(10.0), decimals(3), seed(1) {}
+};
+
+/**
+ * @brief Generador reproducible de grafos sintéticos para pruebas de escala
+ *
+ * Genera las aristas (índices 0-based) de un grafo de la familia pedida en
+ * tiempo O(V + E), sin recorrer todos los pares, de modo que se pueden
+ * generar grafos dispersos de millones de vértices. La misma semilla da
+ * siempre el mismo grafo: el generador de números (std::mt19937_64) y las
+ * conversiones a real están fijados por el estándar o implementados aquí.
+ * Los costes se redondean a options.decimals decimales, así que escribir el
+ * grafo en texto y volver a leerlo da exactamente los mismos costes.
+ */
+bool GenerateGraphEdges(const GeneratorOptions& options, std::vector<GraphEdge>& edges, std::string& error);
+bool ParseGraphFamily(const std::string& name, GraphFamily& family);
+bool ParseWeightDistribution(const std::string& name, WeightDistribution& weights);
+
+#endif
@@ -0,0 +1,223 @@
+#include "graph_memory.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+// Política de mbind(2) que reparte las páginas por turnos entre los nodos
+const int kMpolInterleave = 3;
+
+// Nodos NUMA en línea según /sys ("0-1,3"); vacío si no se puede leer
+std::vector<int> OnlineNodes() {
+  std::vector<int> nodes;
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string text;
+  if (!(file >> text)) {
+    return nodes;
+  }
+  
+  std::size_t pos = 0;
+  while (pos < text.size()) {
+    std::size_t comma = text.find(',', pos);
+    std::string range = text.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+    std::size_t dash = range.find('-');
+    int first = std::atoi(range.c_str());
+    int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+    for (int node = first; node <= last; ++node) {
+      nodes.push_back(node);
+    }
+    pos = comma == std::string::npos ? text.size() : comma + 1;
+  }
+  return nodes;
+}
+
+// Reparte las páginas de [data, data + bytes) por turnos entre los nodos en
+// línea. Sin soporte NUMA en el núcleo la llamada falla y no cambia nada
+void Interleave(void* data, std::size_t bytes) {
+  std::vector<int> nodes = OnlineNodes();
+  if (nodes.size() < 2) {
+    return;
+  }
+  
+  int max_node = *std::max_element(nodes.begin(), nodes.end());
+  std::vector<unsigned long> mask(max_node / (8 * sizeof(unsigned long)) + 1, 0);
+  for (int node : nodes) {
+    mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+  }
+  syscall(SYS_mbind, data, bytes, kMpolInterleave, mask.data(), static_cast<unsigned long>(max_node + 2), 0);
+}
+
+}  // namespace
+
+GraphMemoryRegion::GraphMemoryRegion() : data_(nullptr), bytes_(0) {
+}
+
+GraphMemoryRegion::~GraphMemoryRegion() {
+  Release();
+}
+
+GraphMemoryRegion::GraphMemoryRegion(GraphMemoryRegion&& other)
+  : data_(other.data_), bytes_(other.bytes_) {
+  other.data_ = nullptr;
+  other.bytes_ = 0;
+}
+
+GraphMemoryRegion& GraphMemoryRegion::operator=(GraphMemoryRegion&& other) {
+  if (this != &other) {
+    Release();
+    data_ = other.data_;
+    bytes_ = other.bytes_;
+    other.data_ = nullptr;
+    other.bytes_ = 0;
+  }
+  return *this;
+}
+
+// Reserva bytes (redondeados a páginas grandes) sin tocarlos: las páginas se
+// asignan a un nodo cuando GraphMemoryFill las escribe por primera vez
+bool GraphMemoryRegion::Allocate(std::size_t bytes, GraphMemory policy) {
+  Release();
+  if (policy == GraphMemory::kDefault || bytes == 0) {
+    return false;
+  }
+  
+  // Se pide una página grande de más para poder alinear el inicio
+  std::size_t rounded = (bytes + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+  std::size_t mapped = rounded + kHugePageBytes;
+  void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return false;
+  }
+  
+  uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+  uintptr_t aligned = (begin + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+  if (aligned > begin) {
+    munmap(raw, aligned - begin);
+  }
+  std::size_t tail = begin + mapped - (aligned + rounded);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void*>(aligned + rounded), tail);
+  }
+  
+  data_ = reinterpret_cast<void*>(aligned);
+  bytes_ = rounded;
+  madvise(data_, bytes_, MADV_HUGEPAGE);
+  if (policy == GraphMemory::kInterleave) {
+    Interleave(data_, bytes_);
+  }
+  return true;
+}
+
+void GraphMemoryRegion::Release() {
+  if (data_ != nullptr) {
+    munmap(data_, bytes_);
+    data_ = nullptr;
+  }
+  bytes_ = 0;
+}
+
+void* GraphMemoryRegion::Data() const {
+  return data_;
+}
+
+GraphMemoryFill::GraphMemoryFill(GraphMemory policy) : policy_(policy) {
+}
+
+GraphMemory GraphMemoryFill::GetPolicy() const {
+  return policy_;
+}
+
+// Anota la copia de bytes de source al principio de target
+void GraphMemoryFill::Add(void* target, const void* source, std::size_t bytes) {
+  Copy copy = {static_cast<char*>(target), static_cast<const char*>(source), bytes};
+  copies_.push_back(copy);
+}
+
+// Hace todas las copias anotadas y libera los orígenes conservados. Con
+// kFirstTouch cada hilo de un único RunPinned copia, de cada región, un
+// bloque contiguo alineado a páginas grandes, que queda así en el nodo de
+// la CPU de ese hilo
+void GraphMemoryFill::Run() {
+  if (policy_ != GraphMemory::kFirstTouch) {
+    for (const Copy& copy : copies_) {
+      std::memcpy(copy.target, copy.source, copy.bytes);
+    }
+  } else if (!copies_.empty()) {
+    RunPinned(NumMemoryWorkers(), [](int k, void* data) {
+      const std::vector<Copy>& copies = *static_cast<const std::vector<Copy>*>(data);
+      std::size_t workers = static_cast<std::size_t>(NumMemoryWorkers());
+      for (const Copy& copy : copies) {
+        std::size_t pages = (copy.bytes + kHugePageBytes - 1) / kHugePageBytes;
+        std::size_t first = std::min(copy.bytes, pages * k / workers * kHugePageBytes);
+        std::size_t last = std::min(copy.bytes, pages * (k + 1) / workers * kHugePageBytes);
+        std::memcpy(copy.target + first, copy.source + first, last - first);
+      }
+    }, &copies_);
+  }
+  copies_.clear();
+  kept_.clear();
+}
+
+int NumaNodeCount() {
+  return std::max<int>(1, static_cast<int>(OnlineNodes().size()));
+}
+
+// Hilos (uno por CPU) entre los que se reparten los bloques de kFirstTouch
+int NumMemoryWorkers() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void RunPinned(int count, void (*task)(int, void*), void* context) {
+  std::vector<std::thread> workers;
+  for (int k = 0; k < count; ++k) {
+    workers.push_back(std::thread([task, context, k]() {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(k % CPU_SETSIZE, &cpus);
+      pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      task(k, context);
+    }));
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+// Nombre de la política tal como se escribe en la opción --memory
+std::string GraphMemoryName(GraphMemory memory) {
+  switch (memory) {
+    case GraphMemory::kHugePages:
+      return "hugepages";
+    case GraphMemory::kInterleave:
+      return "interleave";
+    case GraphMemory::kFirstTouch:
+      return "first-touch";
+    default:
+      return "default";
+  }
+}
+
+bool ParseGraphMemory(const std::string& name, GraphMemory& memory) {
+  if (name == "default") {
+    memory = GraphMemory::kDefault;
+  } else if (name == "hugepages") {
+    memory = GraphMemory::kHugePages;
+  } else if (name == "interleave") {
+    memory = GraphMemory::kInterleave;
+  } else if (name == "first-touch") {
+    memory = GraphMemory::kFirstTouch;
+  } else {
+    return false;
+  }
+  return true;
+}
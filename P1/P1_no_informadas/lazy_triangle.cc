@@ -0,0 +1,193 @@
+#include "lazy_triangle.h"
+#include "text_scanner.h"
+#include <algorithm>
+
+namespace {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+const char* SkipSpaces(const char* p, const char* end) {
+  while (p < end && IsSpace(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+const char* SkipToken(const char* p, const char* end) {
+  while (p < end && !IsSpace(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+}  // namespace
+
+LazyTriangle::LazyTriangle()
+  : begin_(nullptr), end_(nullptr), num_vertices_(0), num_edges_(0), capacity_(kDefaultLazyCacheEntries),
+    cached_entries_(0), decoded_rows_(0) {
+}
+
+// Construye el índice disperso del triángulo que empieza en begin (justo
+// después del número de vértices) y cuenta sus aristas. Cada valor se lee
+// con TextScanner igual que en la carga completa, así que un fichero con un
+// valor ilegible o incompleto se rechaza aquí con el mismo mensaje en lugar
+// de tomarse después como sin arista. Cada número debe ocupar su token
+// completo, porque las posiciones del índice se recorren por tokens
+bool LazyTriangle::Build(const char* begin, const char* end, int num_vertices, std::string& error) {
+  Clear();
+  begin_ = begin;
+  end_ = end;
+  num_vertices_ = num_vertices;
+  first_checkpoint_.assign(num_vertices_ + 1, 0);
+  
+  const char* p = begin;
+  for (int i = 0; i < num_vertices_; ++i) {
+    first_checkpoint_[i] = checkpoints_.size();
+    for (int j = i + 1; j < num_vertices_; ++j) {
+      p = SkipSpaces(p, end);
+      std::size_t t = static_cast<std::size_t>(j - i - 1);
+      if (t % kLazyIndexStride == 0) {
+        checkpoints_.push_back(static_cast<uint64_t>(p - begin));
+      }
+  
+      TextScanner scanner(p, end);
+      double value;
+      if (!scanner.NextDistance(value) || !scanner.AtTokenBoundary()) {
+        error = "No se pudo leer la distancia entre vértices " + std::to_string(i + 1) + " y " +
+                std::to_string(j + 1);
+        Clear();
+        return false;
+      }
+      if (value >= 0) {
+        num_edges_++;
+      }
+      p = scanner.Position();
+    }
+  }
+  first_checkpoint_[num_vertices_] = checkpoints_.size();
+  return true;
+}
+
+void LazyTriangle::Clear() {
+  begin_ = nullptr;
+  end_ = nullptr;
+  num_vertices_ = 0;
+  num_edges_ = 0;
+  checkpoints_.clear();
+  checkpoints_.shrink_to_fit();
+  first_checkpoint_.clear();
+  first_checkpoint_.shrink_to_fit();
+  lru_.clear();
+  cache_.clear();
+  cached_entries_ = 0;
+  decoded_rows_ = 0;
+}
+
+void LazyTriangle::SetCacheCapacity(std::size_t entries) {
+  capacity_ = entries;
+  Evict();
+}
+
+long long LazyTriangle::NumEdges() const {
+  return num_edges_;
+}
+
+// Coste de la arista {from_index, to_index} leído directamente del texto
+// (-1 si no existe), sin pasar por la caché: O(kLazyIndexStride)
+double LazyTriangle::ReadCost(int from_index, int to_index) const {
+  if (from_index > to_index) {
+    std::swap(from_index, to_index);
+  }
+  return ParseCost(Locate(from_index, to_index));
+}
+
+// Primer carácter del valor del par (from_index, to_index), con from_index < to_index
+const char* LazyTriangle::Locate(int from_index, int to_index) const {
+  std::size_t token = static_cast<std::size_t>(to_index - from_index - 1);
+  const char* p = begin_ + checkpoints_[first_checkpoint_[from_index] + token / kLazyIndexStride];
+  for (std::size_t k = token % kLazyIndexStride; k > 0; --k) {
+    p = SkipSpaces(SkipToken(p, end_), end_);
+  }
+  return p;
+}
+
+// Build ya comprobó que todos los valores se pueden leer
+double LazyTriangle::ParseCost(const char* token) const {
+  TextScanner scanner(token, end_);
+  double value = -1.0;
+  scanner.NextDistance(value);
+  return value >= 0 ? value : -1.0;
+}
+
+// Vecinos del vértice en orden creciente: columna vertex_index de las filas
+// anteriores (un salto por el índice en cada una) y después su propia fila,
+// que se lee seguida
+std::shared_ptr<const LazyRow> LazyTriangle::DecodeRow(int vertex_index) const {
+  std::shared_ptr<LazyRow> row = std::make_shared<LazyRow>();
+  for (int i = 0; i < vertex_index; ++i) {
+    double cost = ParseCost(Locate(i, vertex_index));
+    if (cost >= 0) {
+      LazyEntry entry = {i, cost};
+      row->push_back(entry);
+    }
+  }
+  
+  if (vertex_index + 1 < num_vertices_) {
+    const char* p = begin_ + checkpoints_[first_checkpoint_[vertex_index]];
+    for (int j = vertex_index + 1; j < num_vertices_; ++j) {
+      double cost = ParseCost(p);
+      if (cost >= 0) {
+        LazyEntry entry = {j, cost};
+        row->push_back(entry);
+      }
+      p = SkipSpaces(SkipToken(p, end_), end_);
+    }
+  }
+  row->shrink_to_fit();
+  return row;
+}
+
+// Vecinos del vértice, decodificados la primera vez y después tomados de la
+// caché. La fila sigue siendo válida aunque se expulse mientras se recorre
+std::shared_ptr<const LazyRow> LazyTriangle::Row(int vertex_index) const {
+  std::unordered_map<int, CacheSlot>::iterator found = cache_.find(vertex_index);
+  if (found != cache_.end()) {
+    lru_.splice(lru_.begin(), lru_, found->second.position);
+    return found->second.row;
+  }
+  
+  std::shared_ptr<const LazyRow> row = DecodeRow(vertex_index);
+  decoded_rows_++;
+  lru_.push_front(vertex_index);
+  CacheSlot slot = {row, lru_.begin()};
+  cache_[vertex_index] = slot;
+  cached_entries_ += row->size() + 1;
+  Evict();
+  return row;
+}
+
+// Expulsa las filas menos usadas hasta respetar la capacidad. La última
+// decodificada se queda aunque ella sola la supere
+void LazyTriangle::Evict() const {
+  while (cached_entries_ > capacity_ && lru_.size() > 1) {
+    std::unordered_map<int, CacheSlot>::iterator victim = cache_.find(lru_.back());
+    cached_entries_ -= victim->second.row->size() + 1;
+    cache_.erase(victim);
+    lru_.pop_back();
+  }
+}
+
+std::size_t LazyTriangle::DecodedRows() const {
+  return decoded_rows_;
+}
+
+std::size_t LazyTriangle::CachedRows() const {
+  return cache_.size();
+}
+
+// Memoria del índice disperso
+std::size_t LazyTriangle::IndexBytes() const {
+  return (checkpoints_.size() + first_checkpoint_.size()) * sizeof(uint64_t);
+}
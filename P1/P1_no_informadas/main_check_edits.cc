@@ -0,0 +1,277 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include "graph.h"
+
+/**
+ * @brief Función para mostrar el uso del comprobador de modificaciones
+ */
+void ShowUsage(const std::string& program_name) {
+  std::cout << "Uso: " << program_name << " [opciones] <archivo_grafo>" << std::endl;
+  std::cout << "  Aplica altas, bajas y cambios de coste de aristas pseudoaleatorios (semilla fija) y" << std::endl;
+  std::cout << "  comprueba costes, vecinos, número de aristas y componentes antes y después de" << std::endl;
+  std::cout << "  compactar. Solo csr, packed y bitset admiten modificaciones." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Opciones:" << std::endl;
+  std::cout << "  --edits=N: modificaciones que se aplican (1000 por defecto)" << std::endl;
+  std::cout << "  --storage=auto|csr|packed|bitset: representación del grafo (auto por defecto)" << std::endl;
+  std::cout << "  Se aceptan también las demás opciones de carga de busquedas_no_informadas (--format," << std::endl;
+  std::cout << "  --reorder, --quantize-weights, --no-snapshot, --memory)" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Ejemplo:" << std::endl;
+  std::cout << "  " << program_name << " --storage=packed --edits=5000 sintetico_er_10k.txt" << std::endl;
+}
+
+// Bajas entre dos comprobaciones de las componentes mientras se modifica
+const int kComponentCheckPeriod = 16;
+
+// Modificaciones aplicadas y estado que deben tener las filas que tocan
+struct EditCheck {
+  std::map<int, std::map<int, double>> rows;   // Vecinos esperados de cada vértice modificado (coste -1: eliminado)
+  long long edges;                             // Aristas que debe tener el grafo
+  int added;
+  int removed;
+  int changed;
+  
+  EditCheck() : edges(0), added(0), removed(0), changed(0) {}
+};
+
+// Fila esperada del vértice; la primera vez se copia del grafo sin modificar
+std::map<int, double>& ExpectedRow(const Graph& graph, EditCheck& check, int vertex) {
+  std::map<int, std::map<int, double>>::iterator found = check.rows.find(vertex);
+  if (found != check.rows.end()) {
+    return found->second;
+  }
+  
+  std::map<int, double>& row = check.rows[vertex];
+  graph.ForEachNeighbor(vertex, [&row](int neighbor, double cost) {
+    row[neighbor] = cost;
+  });
+  return row;
+}
+
+// Componente de cada vértice según recorridos en anchura, independiente de
+// las etiquetas que mantiene Graph
+std::vector<int> ReachableLabels(const Graph& graph) {
+  std::vector<int> labels(graph.GetNumVertices() + 1, -1);
+  std::vector<int> queue;
+  int next_label = 0;
+  for (int start = 1; start <= graph.GetNumVertices(); ++start) {
+    if (labels[start] >= 0) {
+      continue;
+    }
+    
+    labels[start] = next_label;
+    queue.assign(1, start);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      graph.ForEachNeighbor(queue[head], [&labels, &queue, next_label](int neighbor, double) {
+        if (labels[neighbor] < 0) {
+          labels[neighbor] = next_label;
+          queue.push_back(neighbor);
+        }
+      });
+    }
+    next_label++;
+  }
+  return labels;
+}
+
+// Indica si hay un camino entre los dos vértices, con un recorrido en anchura
+bool Reachable(const Graph& graph, int from, int to) {
+  std::vector<char> reached(graph.GetNumVertices() + 1, 0);
+  std::vector<int> queue(1, from);
+  reached[from] = 1;
+  for (std::size_t head = 0; head < queue.size() && !reached[to]; ++head) {
+    graph.ForEachNeighbor(queue[head], [&reached, &queue](int neighbor, double) {
+      if (!reached[neighbor]) {
+        reached[neighbor] = 1;
+        queue.push_back(neighbor);
+      }
+    });
+  }
+  return reached[to] != 0;
+}
+
+/**
+ * @brief Aplica count modificaciones pseudoaleatorias de aristas
+ *
+ * La mitad de las veces se elige un vecino actual del vértice (que se
+ * elimina o cambia de coste) y la otra mitad un vértice cualquiera (alta o
+ * cambio). Los costes son múltiplos de 1/8, exactos en float y con tres
+ * decimales, para que todas las representaciones los guarden sin pérdida.
+ * Cada kComponentCheckPeriod bajas se comprueba en el momento que
+ * SameComponent vuelve a etiquetar las componentes de los extremos.
+ */
+bool ApplyEdits(Graph& graph, int count, EditCheck& check, std::string& error) {
+  int vertices = graph.GetNumVertices();
+  if (vertices < 2) {
+    error = "el grafo necesita al menos dos vértices";
+    return false;
+  }
+  
+  std::mt19937 rng(1);
+  check.edges = graph.GetNumEdges();
+  for (int k = 0; k < count; ++k) {
+    int from = static_cast<int>(rng() % vertices) + 1;
+    std::map<int, double>& from_row = ExpectedRow(graph, check, from);
+    std::vector<int> current;
+    for (const std::pair<const int, double>& entry : from_row) {
+      if (entry.second >= 0) {
+        current.push_back(entry.first);
+      }
+    }
+    
+    int to;
+    if (!current.empty() && rng() % 2 == 0) {
+      to = current[rng() % current.size()];
+    } else {
+      to = static_cast<int>(rng() % (vertices - 1)) + 1;
+      to += to >= from;
+    }
+    std::map<int, double>& to_row = ExpectedRow(graph, check, to);
+    
+    std::map<int, double>::iterator edge = from_row.find(to);
+    bool exists = edge != from_row.end() && edge->second >= 0;
+    double cost = -1.0;
+    if (exists && rng() % 2 == 0) {
+      if (!graph.RemoveEdge(from, to)) {
+        error = "no se pudo eliminar la arista " + std::to_string(from) + "-" + std::to_string(to);
+        return false;
+      }
+      check.edges--;
+      check.removed++;
+      if (check.removed % kComponentCheckPeriod == 0 &&
+          graph.SameComponent(from, to) != Reachable(graph, from, to)) {
+        error = "tras eliminar la arista " + std::to_string(from) + "-" + std::to_string(to) +
+                " sus componentes no coinciden con la conectividad del grafo";
+        return false;
+      }
+    } else {
+      cost = static_cast<double>(rng() % 8000) / 8.0;
+      if (!graph.SetEdgeCost(from, to, cost)) {
+        error = "la representación " + GraphStorageName(graph.GetStorage()) + " no admite modificaciones";
+        return false;
+      }
+      if (exists) {
+        check.changed++;
+      } else {
+        check.edges++;
+        check.added++;
+      }
+    }
+    from_row[to] = cost;
+    to_row[from] = cost;
+  }
+  return true;
+}
+
+/**
+ * @brief Compara el grafo con el estado esperado tras las modificaciones
+ *
+ * Comprueba el número de aristas (el que se mantiene al modificar y el que
+ * da CalculateEdges), los vecinos de cada vértice modificado, GetEdgeCost y
+ * HasEdge de cada par tocado y que SameComponent coincide para ellos con la
+ * conectividad real.
+ */
+bool CheckEdits(Graph& graph, const EditCheck& check, std::string& error) {
+  long long kept_edges = graph.GetNumEdges();
+  graph.CalculateEdges();
+  if (kept_edges != check.edges || graph.GetNumEdges() != check.edges) {
+    error = "el grafo tiene " + std::to_string(kept_edges) + " aristas (" + std::to_string(graph.GetNumEdges()) +
+            " al recontarlas) y se esperaban " + std::to_string(check.edges);
+    return false;
+  }
+  
+  std::vector<int> labels = ReachableLabels(graph);
+  for (const std::pair<const int, std::map<int, double>>& row : check.rows) {
+    int vertex = row.first;
+    std::map<int, double> expected;
+    for (const std::pair<const int, double>& entry : row.second) {
+      if (entry.second >= 0) {
+        expected[entry.first] = entry.second;
+      }
+    }
+    std::map<int, double> neighbors;
+    graph.ForEachNeighbor(vertex, [&neighbors](int neighbor, double cost) {
+      neighbors[neighbor] = cost;
+    });
+    if (neighbors != expected) {
+      error = "los vecinos del vértice " + std::to_string(vertex) + " no son los esperados";
+      return false;
+    }
+    
+    for (const std::pair<const int, double>& entry : row.second) {
+      int other = entry.first;
+      if (graph.GetEdgeCost(vertex, other) != entry.second || graph.HasEdge(vertex, other) != (entry.second >= 0)) {
+        error = "coste incorrecto en la arista " + std::to_string(vertex) + "-" + std::to_string(other);
+        return false;
+      }
+      if (vertex < other && graph.SameComponent(vertex, other) != (labels[vertex] == labels[other])) {
+        error = "las componentes de " + std::to_string(vertex) + " y " + std::to_string(other) +
+                " no coinciden con la conectividad del grafo";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> args;
+  GraphLoadOptions options;
+  int edits = 1000;
+  const std::string kEdits = "--edits=";
+  
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool valid = true;
+    if (arg.compare(0, kEdits.size(), kEdits) == 0) {
+      std::string value = arg.substr(kEdits.size());
+      char* end = nullptr;
+      edits = static_cast<int>(std::strtol(value.c_str(), &end, 10));
+      valid = !value.empty() && *end == '\0' && edits >= 0;
+    } else if (arg.compare(0, 2, "--") == 0) {
+      valid = ParseGraphLoadOption(arg, options);
+    } else {
+      args.push_back(arg);
+    }
+    
+    if (!valid) {
+      std::cerr << "Error: Opción no reconocida: " << arg << std::endl;
+      ShowUsage(argv[0]);
+      return 1;
+    }
+  }
+  
+  if (args.size() != 1) {
+    ShowUsage(argv[0]);
+    return 1;
+  }
+  
+  Graph graph(args[0], options);
+  if (graph.GetNumVertices() == 0) {
+    std::cerr << "Error: No se pudo cargar el grafo" << std::endl;
+    return 1;
+  }
+  
+  EditCheck check;
+  std::string error;
+  bool correct = ApplyEdits(graph, edits, check, error) && CheckEdits(graph, check, error);
+  if (correct) {
+    graph.Compact();
+    correct = CheckEdits(graph, check, error);
+  }
+  if (!correct) {
+    std::cerr << "Error: Modificaciones de aristas: " << error << std::endl;
+    return 1;
+  }
+  
+  std::cout << GraphStorageName(graph.GetStorage()) << ": " << edits << " modificaciones de aristas ("
+            << check.added << " altas, " << check.removed << " bajas, " << check.changed
+            << " cambios de coste) comprobadas antes y después de compactar; " << graph.GetNumEdges()
+            << " aristas" << std::endl;
+  return 0;
+}
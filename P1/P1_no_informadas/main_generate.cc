@@ -0,0 +1,142 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "graph_formats.h"
+#include "graph_generator.h"
+
+/**
+ * @brief Función para mostrar el uso del generador
+ */
+void ShowUsage(const std::string& program_name) {
+  std::cout << "Uso: " << program_name << " [opciones] <archivo_salida>" << std::endl;
+  std::cout << "  Genera un grafo sintético reproducible para pruebas de rendimiento." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Opciones:" << std::endl;
+  std::cout << "  --family=er|geometric|grid: familia del grafo (er por defecto)" << std::endl;
+  std::cout << "                        er: cada par es arista con probabilidad <densidad>" << std::endl;
+  std::cout << "                        geometric: puntos en el cuadrado unidad unidos si están a" << std::endl;
+  std::cout << "                                   distancia < r, con pi r^2 = <densidad>" << std::endl;
+  std::cout << "                        grid: rejilla de 4 vecinos; cada arista se conserva con" << std::endl;
+  std::cout << "                              probabilidad <densidad> (1 por defecto)" << std::endl;
+  std::cout << "  --vertices=N: número de vértices (1000 por defecto)" << std::endl;
+  std::cout << "  --density=p: densidad entre 0 y 1 (0.01 por defecto)" << std::endl;
+  std::cout << "  --weights=uniform|integer|unit|distance: distribución de los costes (uniform por" << std::endl;
+  std::cout << "                        defecto; distance solo en geometric)" << std::endl;
+  std::cout << "  --min-weight=w, --max-weight=w: rango de los costes (0.5 y 10 por defecto)" << std::endl;
+  std::cout << "  --decimals=d: decimales de los costes (3 por defecto)" << std::endl;
+  std::cout << "  --seed=s: semilla (1 por defecto); la misma semilla da el mismo grafo" << std::endl;
+  std::cout << "  --format=auto|triangle|edges|dimacs|binary: formato de salida (auto por defecto:" << std::endl;
+  std::cout << "                        .bin binario, .gr DIMACS, .el/.edges lista de aristas y" << std::endl;
+  std::cout << "                        cualquier otra extensión el triángulo de distancias, que" << std::endl;
+  std::cout << "                        ocupa O(V^2))" << std::endl;
+  std::cout << "  --storage=csr|packed|bitset|compressed|auto: representación guardada en el formato binario" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Ejemplos:" << std::endl;
+  std::cout << "  " << program_name << " --vertices=5000 --density=0.002 er_5k.txt" << std::endl;
+  std::cout << "  " << program_name << " --family=grid --vertices=1000000 --seed=7 grid_1m.bin" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  GeneratorOptions generator;
+  GraphStorage storage = GraphStorage::kCsr;
+  std::string format = "auto";
+  bool density_given = false;
+  std::vector<std::string> args;
+  
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      std::size_t equals = arg.find('=');
+      std::string name = arg.substr(0, equals);
+      std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+      bool valid = true;
+      
+      if (arg.compare(0, 2, "--") != 0) {
+        args.push_back(arg);
+      } else if (name == "--family") {
+        valid = ParseGraphFamily(value, generator.family);
+      } else if (name == "--vertices") {
+        generator.num_vertices = std::stoi(value);
+      } else if (name == "--density") {
+        generator.density = std::stod(value);
+        density_given = true;
+      } else if (name == "--weights") {
+        valid = ParseWeightDistribution(value, generator.weights);
+      } else if (name == "--min-weight") {
+        generator.min_weight = std::stod(value);
+      } else if (name == "--max-weight") {
+        generator.max_weight = std::stod(value);
+      } else if (name == "--decimals") {
+        generator.decimals = std::stoi(value);
+      } else if (name == "--seed") {
+        generator.seed = std::stoull(value);
+      } else if (name == "--format") {
+        GraphFileFormat text_format;
+        format = value;
+        valid = format == "binary" || ParseGraphFileFormat(format, text_format);
+      } else if (name == "--storage") {
+        // lazy lee de un triángulo de texto ya escrito: no sirve para guardar un binario
+        valid = ParseGraphStorage(value, storage) && storage != GraphStorage::kLazy;
+      } else {
+        valid = false;
+      }
+      
+      if (!valid) {
+        std::cerr << "Error: Opción no reconocida: " << arg << std::endl;
+        ShowUsage(argv[0]);
+        return 1;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: Los valores numéricos de las opciones no son válidos" << std::endl;
+    return 1;
+  }
+  
+  if (args.size() != 1) {
+    ShowUsage(argv[0]);
+    return 1;
+  }
+  
+  if (!density_given && generator.family == GraphFamily::kGrid) {
+    generator.density = 1.0;
+  }
+  
+  std::string output = args[0];
+  if (format == "auto") {
+    bool binary = output.size() >= 4 && output.compare(output.size() - 4, 4, ".bin") == 0;
+    GraphFileFormat detected = DetectGraphFileFormat(output);
+    format = binary ? "binary" : detected == GraphFileFormat::kDimacs ? "dimacs"
+           : detected == GraphFileFormat::kEdgeList ? "edges" : "triangle";
+  }
+  
+  std::vector<GraphEdge> edges;
+  std::string error;
+  if (!GenerateGraphEdges(generator, edges, error)) {
+    std::cerr << "Error: " << error << std::endl;
+    return 1;
+  }
+  NormalizeEdges(edges);
+  std::size_t num_edges = edges.size();
+  
+  bool written;
+  if (format == "binary") {
+    Graph graph;
+    written = graph.LoadFromEdges(generator.num_vertices, edges, storage) && graph.SaveBinary(output);
+  } else if (format == "dimacs") {
+    written = WriteDimacsGraph(output, generator.num_vertices, edges, generator.decimals);
+  } else if (format == "edges") {
+    written = WriteEdgeList(output, edges, generator.decimals);
+  } else {
+    written = WriteTriangle(output, generator.num_vertices, edges, generator.decimals);
+  }
+  
+  if (!written) {
+    std::cerr << "Error: No se pudo escribir el archivo " << output << std::endl;
+    return 1;
+  }
+  
+  std::cout << "Grafo de " << generator.num_vertices << " vértices y " << num_edges
+            << " aristas guardado en " << output << " (" << format << ", semilla " << generator.seed << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "graph.h"
+#include "graph_formats.h"
+#include "mapped_file.h"
+#include "bfs.h"
+#include "dfs.h"
+
+/**
+ * @brief Función para mostrar el uso del ejecutor de consultas
+ */
+void ShowUsage(const std::string& program_name) {
+  std::cout << "Uso: " << program_name << " [opciones] <archivo_grafo> <archivo_consultas>" << std::endl;
+  std::cout << "  Ejecuta un conjunto de consultas DIMACS sobre el grafo y mide el tiempo de cada una." << std::endl;
+  std::cout << "  archivo_consultas: fichero .p2p (\"q origen destino\") o .ss (\"s origen\"); las" << std::endl;
+  std::cout << "                     consultas .ss no tienen destino y recorren la componente del origen" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Opciones:" << std::endl;
+  std::cout << "  --algorithm=bfs|dfs|both: algoritmos que se ejecutan (both por defecto)" << std::endl;
+  std::cout << "  --storage=auto|csr|packed|bitset|compressed|lazy: representación del grafo en memoria (auto" << std::endl;
+  std::cout << "                        por defecto: según la densidad, y csr si algún coste no es" << std::endl;
+  std::cout << "                        exacto en float, como los decimales del tipo 2.236; lazy lee" << std::endl;
+  std::cout << "                        del triángulo de texto solo las filas que recorren las consultas)" << std::endl;
+  std::cout << "  --lazy-cache=N: vecinos decodificados que conserva lazy entre consultas" << std::endl;
+  std::cout << "  --trace=none|counters|full: registro del recorrido de cada búsqueda (none por defecto;" << std::endl;
+  std::cout << "                 counters añade a los totales los nodos inspeccionados)" << std::endl;
+  std::cout << "  --format=auto|triangle|edges|dimacs: formato del archivo de grafo (auto por defecto)" << std::endl;
+  std::cout << "  --reorder=none|rcm|degree: renumeración interna de los vértices (none por defecto)" << std::endl;
+  std::cout << "  --no-snapshot: no usar ni crear la instantánea binaria del grafo" << std::endl;
+  std::cout << "  --quantize-weights: costes csr en enteros de 16/32 bits si no se pierde precisión" << std::endl;
+  std::cout << "  --memory=default|hugepages|interleave|first-touch: ubicación de los arrays del grafo" << std::endl;
+  std::cout << "  --shared=nombre: tomar el grafo del segmento de memoria compartida nombre, o cargarlo" << std::endl;
+  std::cout << "                 y publicarlo ahí si todavía no existe" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Ejemplo:" << std::endl;
+  std::cout << "  " << program_name << " --algorithm=bfs USA-road-d.NY.gr USA-road-d.NY.p2p" << std::endl;
+}
+
+// Tiempos acumulados de un algoritmo sobre todas las consultas
+struct QueryTotals {
+  int queries;
+  int found;
+  double milliseconds;
+  long long inspected;    // Nodos inspeccionados (si la búsqueda los registra)
+  
+  QueryTotals() : queries(0), found(0), milliseconds(0.0), inspected(0) {}
+};
+
+// Las consultas .ss llegan con goal 0 (ver GraphQuery), que las búsquedas
+// ya interpretan como "sin destino"
+static_assert(SearchAlgorithm::kNoGoal == 0, "GraphQuery usa goal 0 como SearchAlgorithm::kNoGoal");
+
+void RunQuery(SearchAlgorithm* algorithm, const Graph& graph, int number, const GraphQuery& query,
+              QueryTotals& totals) {
+  std::cout << std::setw(8) << number << "  " << std::setw(4) << algorithm->GetAlgorithmName()
+            << "  " << std::setw(9) << query.start << "  " << std::setw(9);
+  if (query.goal == SearchAlgorithm::kNoGoal) {
+    std::cout << "-";
+  } else {
+    std::cout << query.goal;
+  }
+  
+  if (!graph.IsValidVertex(query.start) || (query.goal != SearchAlgorithm::kNoGoal && !graph.IsValidVertex(query.goal))) {
+    std::cout << "  vértice inválido" << std::endl;
+    return;
+  }
+  
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  SearchResult result = algorithm->Search(query.start, query.goal);
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  double milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+  
+  totals.queries++;
+  totals.milliseconds += milliseconds;
+  totals.inspected += result.inspected_count;
+  if (result.path_found) {
+    totals.found++;
+  }
+  
+  // Las consultas sin destino solo recorren la componente: no hay camino que mostrar
+  std::string found = query.goal == SearchAlgorithm::kNoGoal ? "recorrido" : (result.path_found ? "sí" : "no");
+  std::cout << "  " << std::setw(10) << found << "  ";
+  if (result.path_found) {
+    std::cout << std::setw(12) << result.total_cost << "  " << std::setw(8) << result.path.size();
+  } else {
+    std::cout << std::setw(12) << "-" << "  " << std::setw(8) << "-";
+  }
+  std::cout << "  " << std::setw(12) << std::fixed << std::setprecision(3) << milliseconds << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+void PrintTotals(const std::string& algorithm_name, const QueryTotals& totals) {
+  std::cout << algorithm_name << ": " << totals.queries << " consultas, " << totals.found
+            << " con camino, tiempo total " << std::fixed << std::setprecision(3) << totals.milliseconds << " ms";
+  if (totals.queries > 0) {
+    std::cout << ", medio " << totals.milliseconds / totals.queries << " ms";
+  }
+  if (totals.inspected > 0) {
+    std::cout << ", " << totals.inspected << " nodos inspeccionados";
+  }
+  std::cout << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> args;
+  GraphLoadOptions options;
+  std::string algorithm_choice = "both";
+  TraceLevel trace = TraceLevel::kNone;
+  const std::string kAlgorithm = "--algorithm=";
+  const std::string kTrace = "--trace=";
+  
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool valid = true;
+    if (arg.compare(0, kAlgorithm.size(), kAlgorithm) == 0) {
+      algorithm_choice = arg.substr(kAlgorithm.size());
+      valid = algorithm_choice == "bfs" || algorithm_choice == "dfs" || algorithm_choice == "both";
+    } else if (arg.compare(0, kTrace.size(), kTrace) == 0) {
+      valid = ParseTraceLevel(arg.substr(kTrace.size()), trace);
+    } else if (arg.compare(0, 2, "--") == 0) {
+      valid = ParseGraphLoadOption(arg, options);
+    } else {
+      args.push_back(arg);
+    }
+    
+    if (!valid) {
+      std::cerr << "Error: Opción no reconocida: " << arg << std::endl;
+      ShowUsage(argv[0]);
+      return 1;
+    }
+  }
+  
+  if (args.size() != 2) {
+    ShowUsage(argv[0]);
+    return 1;
+  }
+  
+  std::chrono::steady_clock::time_point load_begin = std::chrono::steady_clock::now();
+  Graph graph(args[0], options);
+  std::chrono::steady_clock::time_point load_end = std::chrono::steady_clock::now();
+  if (graph.GetNumVertices() == 0) {
+    std::cerr << "Error: No se pudo cargar el grafo" << std::endl;
+    return 1;
+  }
+  
+  MappedFile query_file;
+  if (!query_file.Open(args[1])) {
+    std::cerr << "Error: No se pudo abrir el archivo " << args[1] << std::endl;
+    return 1;
+  }
+  
+  std::vector<GraphQuery> queries;
+  std::string error;
+  if (!ReadDimacsQueries(query_file.Data(), query_file.Data() + query_file.Size(), queries, error)) {
+    std::cerr << "Error: " << args[1] << ": " << error << std::endl;
+    return 1;
+  }
+  
+  std::cout << "Grafo cargado: " << graph.GetNumVertices() << " vértices, " << graph.GetNumEdges()
+            << " aristas en " << std::fixed << std::setprecision(3)
+            << std::chrono::duration<double, std::milli>(load_end - load_begin).count() << " ms" << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+  
+  std::cout << queries.size() << " consultas en " << args[1] << std::endl;
+  std::cout << std::endl;
+  std::cout << "Consulta  Alg.     Origen    Destino  Encontrado         Coste  Longitud   Tiempo (ms)" << std::endl;
+  
+  // Los informes por iteración no se muestran: por defecto no se registra nada
+  BFS bfs_algorithm(&graph, trace);
+  DFS dfs_algorithm(&graph, trace);
+  QueryTotals bfs_totals;
+  QueryTotals dfs_totals;
+  
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    int number = static_cast<int>(q) + 1;
+    if (algorithm_choice == "bfs" || algorithm_choice == "both") {
+      RunQuery(&bfs_algorithm, graph, number, queries[q], bfs_totals);
+    }
+    if (algorithm_choice == "dfs" || algorithm_choice == "both") {
+      RunQuery(&dfs_algorithm, graph, number, queries[q], dfs_totals);
+    }
+  }
+  
+  std::cout << std::endl;
+  if (algorithm_choice == "bfs" || algorithm_choice == "both") {
+    PrintTotals(bfs_algorithm.GetAlgorithmName(), bfs_totals);
+  }
+  if (algorithm_choice == "dfs" || algorithm_choice == "both") {
+    PrintTotals(dfs_algorithm.GetAlgorithmName(), dfs_totals);
+  }
+  if (graph.GetStorage() == GraphStorage::kLazy) {
+    std::cout << "Filas decodificadas bajo demanda: " << graph.GetLazyRows().DecodedRows() << " de "
+              << graph.GetNumVertices() << std::endl;
+  }
+  
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include "mapped_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : fd_(-1), data_(nullptr), size_(0) {
+}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+// Abre y proyecta el fichero completo. Un fichero vacío se abre sin proyección
+bool MappedFile::Open(const std::string& filename) {
+  Close();
+  
+  fd_ = open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    return false;
+  }
+  return Map();
+}
+
+// Abre y proyecta el segmento de memoria compartida name ("/nombre"). Las
+// páginas son las del segmento: abrirlo no copia nada, sea cual sea su tamaño
+bool MappedFile::OpenShared(const std::string& name) {
+  Close();
+  
+  fd_ = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd_ < 0) {
+    return false;
+  }
+  return Map();
+}
+
+// Proyecta el contenido completo del descriptor fd_ ya abierto
+bool MappedFile::Map() {
+  struct stat info;
+  if (fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode)) {
+    Close();
+    return false;
+  }
+  
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ == 0) {
+    return true;
+  }
+  
+  data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    Close();
+    return false;
+  }
+  
+  return true;
+}
+
+// Avisa al sistema de que el contenido se va a leer de principio a fin
+void MappedFile::AdviseSequential() const {
+  if (data_ != nullptr) {
+    madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+}
+
+void MappedFile::Close() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  size_ = 0;
+}
+
+bool MappedFile::IsOpen() const {
+  return fd_ >= 0;
+}
+
+const char* MappedFile::Data() const {
+  return static_cast<const char*>(data_);
+}
+
+std::size_t MappedFile::Size() const {
+  return size_;
+}
@@ -1,18 +1,6 @@
 #include "node.h"
 
-Node::Node(int vertex, std::shared_ptr<Node> parent, double path_cost)
-  : vertex_(vertex), parent_(parent), path_cost_(path_cost) {
+// Vacía el arena conservando su capacidad para la siguiente búsqueda
+void NodeArena::Clear() {
+  nodes_.clear();
 }
-
-// Getters
-int Node::GetVertex() const {
-  return vertex_;
-}
-
-std::shared_ptr<Node> Node::GetParent() const {
-  return parent_;
-}
-
-double Node::GetPathCost() const {
-  return path_cost_;
-}
\ No newline at end of file
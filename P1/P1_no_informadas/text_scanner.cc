@@ -0,0 +1,35 @@
+#include "text_scanner.h"
+#include <cstdlib>
+#include <string>
+
+// Conversión general con strtod para los casos que no cubre el camino rápido
+bool TextScanner::ParseSlow(const char* token, double& value) {
+  const char* p = token;
+  while (p < end_ && !IsSpace(*p)) {
+    ++p;
+  }
+  
+  // strtod necesita una cadena terminada en '\0'
+  std::string text(token, p);
+  char* parsed_end = nullptr;
+  double result = std::strtod(text.c_str(), &parsed_end);
+  if (parsed_end == text.c_str()) {
+    return false;
+  }
+  
+  cur_ = token + (parsed_end - text.c_str());
+  value = result < 0 ? -1.0 : result;
+  return true;
+}
+
+// Cuenta los tokens separados por espacio en blanco de [begin, end)
+std::size_t TextScanner::CountTokens(const char* begin, const char* end) {
+  std::size_t count = 0;
+  bool in_space = true;
+  for (const char* p = begin; p < end; ++p) {
+    bool space = IsSpace(*p);
+    count += (in_space && !space);
+    in_space = space;
+  }
+  return count;
+}